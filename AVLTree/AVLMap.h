@@ -0,0 +1,414 @@
+// File: AVLMap.h
+// Description: Header only ordered map built on an AVL tree. Each node holds
+// a key and an associated value. Keys are ordered by Compare, which defaults
+// to std::less<K>. Because the tree is a template the comparator and the
+// rebalance/rotation code are instantiated per key type, so an
+// AVLMap<int, V> compiles down to the same integer comparisons AVLTree uses.
+// An optional Aggregate policy stores a summary of every subtree in its
+// root, e.g. the sum of its values, so aggregate(lo, hi) can combine the
+// values of any key range in O(log n).
+
+#ifndef AVLMAP_H
+#define AVLMAP_H
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <utility>
+#include <vector>
+
+// An Aggregate policy supplies an associative combine with an identity
+// element, and lift, which turns one key and value into a summary:
+//   typedef ... type;
+//   static type identity();
+//   static type lift(const K&, const V&);
+//   static type combine(const type&, const type&);
+// combine need not be commutative; summaries are always combined in key
+// order.
+
+// Default policy, keeps no summary.
+template <typename K, typename V>
+struct AVLMapNoAggregate{
+  struct type{};
+  static type identity(){ return type(); }
+  static type lift(const K&, const V&){ return type(); }
+  static type combine(const type&, const type&){ return type(); }
+};
+
+template <typename K, typename V>
+struct AVLMapSum{
+  typedef V type;
+  static type identity(){ return V(); }
+  static type lift(const K&, const V& value){ return value; }
+  static type combine(const type& a, const type& b){ return a + b; }
+};
+
+template <typename K, typename V>
+struct AVLMapMin{
+  typedef V type;
+  static type identity(){ return std::numeric_limits<V>::max(); }
+  static type lift(const K&, const V& value){ return value; }
+  static type combine(const type& a, const type& b){ return std::min(a, b); }
+};
+
+template <typename K, typename V>
+struct AVLMapMax{
+  typedef V type;
+  static type identity(){ return std::numeric_limits<V>::lowest(); }
+  static type lift(const K&, const V& value){ return value; }
+  static type combine(const type& a, const type& b){ return std::max(a, b); }
+};
+
+template <typename K, typename V, typename S = typename AVLMapNoAggregate<K, V>::type>
+class AVLMapNode{
+  public:
+    K key;
+    V value;
+    int height;
+    S summary; // aggregate of every key and value in this subtree
+    std::shared_ptr<AVLMapNode> left;
+    std::shared_ptr<AVLMapNode> right;
+
+    template <typename KArg, typename... VArgs>
+    AVLMapNode(KArg&& k, VArgs&&... args)
+      : key(std::forward<KArg>(k)), value(std::forward<VArgs>(args)...), height(0), summary() {}
+};
+
+template <typename K, typename V, typename Compare = std::less<K>, typename Aggregate = AVLMapNoAggregate<K, V>>
+class AVLMap{
+  public:
+    typedef typename Aggregate::type Summary;
+    typedef AVLMapNode<K, V, Summary> Node;
+
+    AVLMap() : root(nullptr), size(0), comp() {}
+    explicit AVLMap(const Compare& c) : root(nullptr), size(0), comp(c) {}
+
+    std::shared_ptr<Node> getRoot(){ return root; }
+    int getSize(){ return size; }
+
+    /*Description: Function returns pointer to node holding key. Else returns
+      nullptr.
+      Parameters: const K& key
+      Returns: std::shared_ptr<Node>
+    */
+    std::shared_ptr<Node> search(const K& key){
+      return find(key);
+    }
+
+    /*Description: Heterogeneous lookup. Only available when Compare declares
+      is_transparent (e.g. std::less<>), so a key can be looked up with any
+      type the comparator accepts without building a temporary K.
+      Parameters: const Q& key
+      Returns: std::shared_ptr<Node>
+    */
+    template <typename Q, typename C = Compare, typename = typename C::is_transparent>
+    std::shared_ptr<Node> search(const Q& key){
+      return find(key);
+    }
+
+    std::shared_ptr<Node> minimum(){
+      Node* n = root.get();
+      if (n == nullptr) {
+        return nullptr;
+      }
+      const std::shared_ptr<Node>* slot = &root;
+      while (n->left != nullptr) {
+        slot = &n->left;
+        n = n->left.get();
+      }
+      return *slot;
+    }
+
+    std::shared_ptr<Node> maximum(){
+      Node* n = root.get();
+      if (n == nullptr) {
+        return nullptr;
+      }
+      const std::shared_ptr<Node>* slot = &root;
+      while (n->right != nullptr) {
+        slot = &n->right;
+        n = n->right.get();
+      }
+      return *slot;
+    }
+
+    /*Description: Function constructs value in place from args if key is not
+      already present. Arguments are forwarded, so keys and values may be
+      moved into the tree. Nothing is allocated when key already exists.
+      Parameters: KArg&& key, VArgs&&... args
+      Returns: std::pair<std::shared_ptr<Node>, bool> - node holding key and
+      whether an insertion took place
+    */
+    template <typename KArg, typename... VArgs>
+    std::pair<std::shared_ptr<Node>, bool> emplace(KArg&& key, VArgs&&... args){
+      std::shared_ptr<Node> result;
+      bool inserted = false;
+      emplace(root, result, inserted, std::forward<KArg>(key), std::forward<VArgs>(args)...);
+      if (inserted) {
+        size = size + 1;
+      }
+      return std::make_pair(result, inserted);
+    }
+
+    /*Description: Function inserts key with value. If key already exists its
+      value is replaced and the summaries above it are recomputed. Values
+      changed directly through a node pointer are not reflected in
+      aggregates, so replace them through insertValue.
+      Parameters: K key, V value
+      Returns: void
+    */
+    void insertValue(K key, V value){
+      std::pair<std::shared_ptr<Node>, bool> r = emplace(std::move(key), std::move(value));
+      if (!r.second) {
+        r.first->value = std::move(value);
+        refresh(root, r.first->key);
+      }
+    }
+
+    /*Description: Function removes node holding key if present.
+      Parameters: const K& key
+      Returns: bool - true if a node was removed
+    */
+    bool deleteValue(const K& key){
+      bool removed = false;
+      deleteValue(root, key, removed);
+      if (removed) {
+        size = size - 1;
+      }
+      return removed;
+    }
+
+    /*Description: Function returns the aggregate of every key and value in
+      the map, or the identity if the map is empty.
+      Parameters: N/A
+      Returns: Summary
+    */
+    Summary aggregate(){
+      return getSummary(root);
+    }
+
+    /*Description: Function returns the aggregate, in key order, of every
+      key and value with lo <= key <= hi. One path is followed down to the
+      first key in range and two more along its lower and upper edges, and
+      whole subtrees in between contribute their stored summary, so the
+      cost is O(log n).
+      Parameters: const K& lo, const K& hi
+      Returns: Summary
+    */
+    Summary aggregate(const K& lo, const K& hi){
+      if (comp(hi, lo)) {
+        return Aggregate::identity();
+      }
+      Node* n = root.get();
+      while (n != nullptr) {
+        if (comp(n->key, lo)) {
+          n = n->right.get();
+        } else if (comp(hi, n->key)) {
+          n = n->left.get();
+        } else {
+          return Aggregate::combine(Aggregate::combine(aggregateFrom(n->left.get(), lo), lift(n)),
+                                    aggregateTo(n->right.get(), hi));
+        }
+      }
+      return Aggregate::identity();
+    }
+
+    void inOrder(std::shared_ptr<Node> n, std::vector<std::shared_ptr<Node>> &order){
+      if (n != nullptr) {
+        inOrder(n->left, order);
+        order.push_back(n);
+        inOrder(n->right, order);
+      }
+    }
+
+  private:
+    std::shared_ptr<Node> root;
+    int size;
+    Compare comp;
+
+    template <typename Q>
+    std::shared_ptr<Node> find(const Q& key){
+      const std::shared_ptr<Node>* slot = &root;
+      while (*slot != nullptr) {
+        Node* n = slot->get();
+        if (comp(key, n->key)) {
+          slot = &n->left;
+        } else if (comp(n->key, key)) {
+          slot = &n->right;
+        } else {
+          return *slot;
+        }
+      }
+      return nullptr;
+    }
+
+    template <typename KArg, typename... VArgs>
+    void emplace(std::shared_ptr<Node>& n, std::shared_ptr<Node>& result, bool& inserted,
+                 KArg&& key, VArgs&&... args){
+      if (n == nullptr) {
+        n = std::make_shared<Node>(std::forward<KArg>(key), std::forward<VArgs>(args)...);
+        updateNode(n);
+        result = n;
+        inserted = true;
+        return;
+      }
+
+      if (comp(key, n->key)) {
+        emplace(n->left, result, inserted, std::forward<KArg>(key), std::forward<VArgs>(args)...);
+      } else if (comp(n->key, key)) {
+        emplace(n->right, result, inserted, std::forward<KArg>(key), std::forward<VArgs>(args)...);
+      } else {
+        result = n;
+        return;
+      }
+
+      if (inserted) {
+        rebalance(n);
+      }
+    }
+
+    void deleteValue(std::shared_ptr<Node>& n, const K& key, bool& removed){
+      if (n == nullptr) {
+        return;
+      }
+
+      if (comp(key, n->key)) {
+        deleteValue(n->left, key, removed);
+      } else if (comp(n->key, key)) {
+        deleteValue(n->right, key, removed);
+      } else {
+        removed = true;
+        if (n->left == nullptr) {
+          n = n->right;
+        } else if (n->right == nullptr) {
+          n = n->left;
+        } else {
+          // Splice the successor node in place of n rather than copying its
+          // key and value, so K and V need not be assignable.
+          std::shared_ptr<Node> successor = removeMinimum(n->right);
+          successor->left = n->left;
+          successor->right = n->right;
+          n = successor;
+        }
+      }
+
+      if (removed && n != nullptr) {
+        rebalance(n);
+      }
+    }
+
+    // Recomputes the summaries on the path from n down to key.
+    void refresh(const std::shared_ptr<Node>& n, const K& key){
+      if (n == nullptr) {
+        return;
+      }
+      if (comp(key, n->key)) {
+        refresh(n->left, key);
+      } else if (comp(n->key, key)) {
+        refresh(n->right, key);
+      }
+      updateNode(n);
+    }
+
+    // Aggregate of the keys >= lo in subtree n.
+    Summary aggregateFrom(const Node* n, const K& lo){
+      Summary right = Aggregate::identity();
+      while (n != nullptr) {
+        if (comp(n->key, lo)) {
+          n = n->right.get();
+        } else {
+          right = Aggregate::combine(Aggregate::combine(lift(n), getSummary(n->right)), right);
+          n = n->left.get();
+        }
+      }
+      return right;
+    }
+
+    // Aggregate of the keys <= hi in subtree n.
+    Summary aggregateTo(const Node* n, const K& hi){
+      Summary left = Aggregate::identity();
+      while (n != nullptr) {
+        if (comp(hi, n->key)) {
+          n = n->left.get();
+        } else {
+          left = Aggregate::combine(left, Aggregate::combine(getSummary(n->left), lift(n)));
+          n = n->right.get();
+        }
+      }
+      return left;
+    }
+
+    static Summary lift(const Node* n){
+      return Aggregate::lift(n->key, n->value);
+    }
+
+    static Summary getSummary(const std::shared_ptr<Node>& n){
+      return n == nullptr ? Aggregate::identity() : n->summary;
+    }
+
+    // Detaches and returns the node with the smallest key of subtree n.
+    std::shared_ptr<Node> removeMinimum(std::shared_ptr<Node>& n){
+      if (n->left == nullptr) {
+        std::shared_ptr<Node> minimumNode = n;
+        n = n->right;
+        minimumNode->right = nullptr;
+        return minimumNode;
+      }
+      std::shared_ptr<Node> minimumNode = removeMinimum(n->left);
+      rebalance(n);
+      return minimumNode;
+    }
+
+    static int getHeight(const std::shared_ptr<Node>& n){
+      return n == nullptr ? -1 : n->height;
+    }
+
+    static int getBalanceFactor(const std::shared_ptr<Node>& n){
+      return getHeight(n->right) - getHeight(n->left);
+    }
+
+    // Recomputes height and summary of n from its children.
+    static void updateNode(const std::shared_ptr<Node>& n){
+      n->height = std::max(getHeight(n->left), getHeight(n->right)) + 1;
+      n->summary = Aggregate::combine(Aggregate::combine(getSummary(n->left), lift(n.get())),
+                                      getSummary(n->right));
+    }
+
+    static void rotateLeft(std::shared_ptr<Node>& n){
+      std::shared_ptr<Node> temp = n->right;
+      n->right = temp->left;
+      updateNode(n);
+      temp->left = n;
+      updateNode(temp);
+      n = temp;
+    }
+
+    static void rotateRight(std::shared_ptr<Node>& n){
+      std::shared_ptr<Node> temp = n->left;
+      n->left = temp->right;
+      updateNode(n);
+      temp->right = n;
+      updateNode(temp);
+      n = temp;
+    }
+
+    // Restores the AVL property at n, replacing n with the new subtree root.
+    static void rebalance(std::shared_ptr<Node>& n){
+      updateNode(n);
+      int balanceFactor = getBalanceFactor(n);
+      if (balanceFactor == 2) {
+        if (getBalanceFactor(n->right) < 0) {
+          rotateRight(n->right);
+        }
+        rotateLeft(n);
+      } else if (balanceFactor == -2) {
+        if (getBalanceFactor(n->left) > 0) {
+          rotateLeft(n->left);
+        }
+        rotateRight(n);
+      }
+    }
+};
+
+#endif
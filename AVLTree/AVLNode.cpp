@@ -7,7 +7,8 @@
 AVLNode::AVLNode(){
   value = 0;
   height = 0;
-  balanceFactor = 0;
+  count = 1;
+  subtreeSize = 1;
   left = nullptr;
   right = nullptr;
   parent = nullptr;
@@ -16,7 +17,8 @@ AVLNode::AVLNode(){
 AVLNode::AVLNode(int v){
   value = v;
   height = 0;
-  balanceFactor = 0;
+  count = 1;
+  subtreeSize = 1;
   left = nullptr;
   right = nullptr;
   parent = nullptr;
@@ -10,11 +10,12 @@
 class AVLNode{
   public:
     int value;
-    int height;
-    int balanceFactor;
+    signed char height; // packed next to value, balance factor is derived from child heights
+    int count; // copies of value held, above 1 only in multiset mode
+    int subtreeSize; // sum of counts in the subtree rooted here, used for rank/select
     std::shared_ptr<AVLNode> left;
     std::shared_ptr<AVLNode> right;
-    std::shared_ptr<AVLNode> parent; // you are not required to update parent nodes but you may use them if you want
+    AVLNode* parent; // non-owning, children are owned through left and right
     
     AVLNode();
     AVLNode(int);
@@ -0,0 +1,97 @@
+// File: AVLNodeArena.h
+// Description: Bump allocator used by AVLTree::buildFromSorted so that the
+// nodes of a freshly built tree, shared_ptr control blocks included, sit
+// in one contiguous block in the order they were built. The arena counts
+// its live allocations and frees the block when the last one is released,
+// so it lives exactly as long as the nodes it holds, whichever tree they
+// have been moved into by then, and it holds no pointers to them. Memory
+// of nodes erased earlier only comes back with the whole block.
+
+#ifndef AVLNODEARENA_H
+#define AVLNODEARENA_H
+
+#include <atomic>
+#include <cstddef>
+#include <new>
+
+class AVLNodeArena{
+  public:
+    // Room is made for blocks allocations of the size first asked for.
+    // Later requests past that room fall back to operator new.
+    explicit AVLNodeArena(size_t blocks) : blocks(blocks), block(nullptr), capacity(0), used(0), live(0) {}
+
+    // Must only be called by the thread building the tree
+    void* allocate(size_t bytes){
+      if (block == nullptr) {
+        capacity = bytes * blocks;
+        block = static_cast<char*>(::operator new(capacity));
+      }
+      live++;
+      if (used + bytes > capacity) {
+        return ::operator new(bytes);
+      }
+      void* p = block + used;
+      used += bytes;
+      return p;
+    }
+
+    // Safe from any thread. Deletes the arena with its last allocation.
+    void deallocate(void* p){
+      char* c = static_cast<char*>(p);
+      if (c < block || c >= block + capacity) {
+        ::operator delete(p);
+      }
+      if (--live == 0) {
+        delete this;
+      }
+    }
+
+  private:
+    size_t blocks;
+    char* block;
+    size_t capacity;
+    size_t used;
+    std::atomic<size_t> live;
+
+    ~AVLNodeArena(){
+      ::operator delete(block);
+    }
+
+    AVLNodeArena(const AVLNodeArena&);
+    AVLNodeArena& operator=(const AVLNodeArena&);
+};
+
+// Allocator handed to std::allocate_shared. Each control block keeps a
+// copy, which is only a pointer to the arena.
+template <typename T>
+class AVLNodeAllocator{
+  public:
+    typedef T value_type;
+
+    AVLNodeArena* arena;
+
+    explicit AVLNodeAllocator(AVLNodeArena* arena) : arena(arena) {}
+
+    template <typename U>
+    AVLNodeAllocator(const AVLNodeAllocator<U> &other) : arena(other.arena) {}
+
+    T* allocate(size_t n){
+      return static_cast<T*>(arena->allocate(n * sizeof(T)));
+    }
+
+    void deallocate(T* p, size_t){
+      arena->deallocate(p);
+    }
+};
+
+template <typename T, typename U>
+bool operator==(const AVLNodeAllocator<T> &a, const AVLNodeAllocator<U> &b){
+  return a.arena == b.arena;
+}
+
+template <typename T, typename U>
+bool operator!=(const AVLNodeAllocator<T> &a, const AVLNodeAllocator<U> &b){
+  return a.arena != b.arena;
+}
+
+#endif
@@ -5,13 +5,40 @@
 
 #include <iostream>
 #include <limits.h>
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <thread>
 #include "AVLTree.h"
+#include "StreamBytes.h"
 using namespace std;
 
+// Counter updates are relaxed atomic adds because the set operations may
+// run on several threads at once when parallelism is above 1.
+#ifdef TREE_STATS
+#define AVL_STAT_ADD(stats, field, n) __atomic_fetch_add(&(stats).field, (n), __ATOMIC_RELAXED)
+#else
+#define AVL_STAT_ADD(stats, field, n) ((void)0)
+#endif
+#define AVL_STAT(field) AVL_STAT_ADD(counters, field, 1)
+
+#ifdef __GNUC__
+#define AVL_PREFETCH(address) __builtin_prefetch(address)
+#else
+#define AVL_PREFETCH(address)
+#endif
+
 // Constructor for AVLTree class
 AVLTree::AVLTree(){
   root = nullptr;
   size = 0;
+  parallelism = 1;
+  multiset = false;
+  counters = AVLTreeStats();
+  finger = nullptr;
 }
 
 /*Description: Function returns pointer to AVLTree root.
@@ -26,7 +53,8 @@ std::shared_ptr<AVLNode> AVLTree::getRoot(){
   return root;
 }
 
-/*Description: Function returns size of AVLTree
+/*Description: Function returns size of AVLTree. In multiset mode every
+  copy of a value is counted.
   Parameters: N/A
   Returns: int size
 */
@@ -34,36 +62,150 @@ int AVLTree::getSize(){
   return size;
 }
 
+/*Description: Function turns multiset mode on or off. In multiset mode
+  inserting a value already present increments the count of its node
+  and deleting it decrements the count, removing the node at zero, so
+  memory stays proportional to the number of distinct values. select,
+  rank and countInRange count every copy. Turning the mode off keeps
+  existing counts but stops further increments. Bulk operations (the
+  static builders, split, join, the set operations, the batch updates,
+  freeze and save) treat the tree as a set of distinct values.
+  Parameters: bool enabled
+  Returns: void
+*/
+void AVLTree::setMultiset(bool enabled){
+  multiset = enabled;
+}
+
+/*Description: Function returns number of copies of val in AVLTree, 0 if
+  val is absent.
+  Parameters: int val
+  Returns: int
+*/
+int AVLTree::count(int val){
+  AVLNode* n = root.get();
+  while (n != nullptr && n->value != val) {
+    n = (n->value < val) ? n->right.get() : n->left.get();
+  }
+  return (n == nullptr) ? 0 : n->count;
+}
+
 /*Description: Function returns pointer to node of AVLTree containing val provided. 
   Else returns nullptr
   Parameters: int val
   Returns: std::shared_ptr<AVLNode>
 */
 std::shared_ptr<AVLNode> AVLTree::search(int val){
-  if (root != nullptr) {
-    return search(root, val);
+  // Walk raw pointers and only copy the shared_ptr that is returned, so a
+  // lookup touches no reference counts on the way down.
+  const std::shared_ptr<AVLNode>* slot = &root;
+  AVLNode* n = root.get();
+  AVL_STAT(searches);
+  while (n != nullptr) {
+    AVL_STAT(nodesVisited);
+    AVL_STAT(comparisons);
+    if (n->value == val) {
+      break;
+    }
+    AVL_STAT(comparisons);
+    slot = (n->value < val) ? &n->right : &n->left;
+    n = slot->get();
   }
+  return (n == nullptr) ? nullptr : *slot;
+}
 
-  return nullptr;
+/*Description: Function looks up every query and stores the matching node,
+  or nullptr, in results. Up to group lookups, at most maxSearchGroup, are
+  in flight at once. Each one moves down a single level, prefetches the
+  child it moved to and hands over to the next, so the cache misses of
+  different lookups overlap instead of each lookup waiting on its own
+  chain of misses. A finished lookup frees its place for the next query.
+  Parameters: const std::vector<int> &queries,
+  std::vector<std::shared_ptr<AVLNode>> &results, int group
+  Returns: void
+*/
+void AVLTree::searchBatch(const std::vector<int> &queries, std::vector<std::shared_ptr<AVLNode>> &results, int group){
+  int count = queries.size();
+  results.assign(count, nullptr);
+  if (group > maxSearchGroup) {
+    group = maxSearchGroup;
+  }
+  if (group < 1) {
+    group = 1;
+  }
+
+  // Lookup in place i has reached the node held by slot[i] on its way to
+  // queries[query[i]]
+  const std::shared_ptr<AVLNode>* slot[maxSearchGroup];
+  int query[maxSearchGroup];
+  int active = 0;
+  int next = 0;
+  for (; active < group && next < count; active++) {
+    slot[active] = &root;
+    query[active] = next++;
+  }
+
+  while (active > 0) {
+    int i = 0;
+    while (i < active) {
+      AVLNode* n = slot[i]->get();
+      int val = queries[query[i]];
+      if (n != nullptr) {
+        AVL_STAT(nodesVisited);
+        AVL_STAT_ADD(counters, comparisons, (n->value == val) ? 1 : 2);
+      }
+      if (n == nullptr || n->value == val) {
+        AVL_STAT(searches);
+        if (n != nullptr) {
+          results[query[i]] = *slot[i];
+        }
+        if (next < count) {
+          slot[i] = &root;
+          query[i] = next++;
+          i++;
+        } else {
+          // Move the last lookup into this place and run it next
+          active--;
+          slot[i] = slot[active];
+          query[i] = query[active];
+        }
+        continue;
+      }
+      slot[i] = (n->value < val) ? &n->right : &n->left;
+      AVL_PREFETCH(slot[i]->get());
+      i++;
+    }
+  }
 }
 
-/*Description: Function returns pointer to node of AVLTree containing val provided. 
-  Else returns nullptr
-  Parameters: std::shared_ptr<AVLNode> n, int val
+/*Description: Function works like search but starts from the node last
+  found or inserted by fingerSearch or fingerInsert. It climbs parent
+  links only as far as the first ancestor whose subtree can hold val and
+  descends from there, so a lookup near the previous one usually costs
+  O(log d) steps for a distance of d values instead of O(log n). If val
+  is found the finger moves to it.
+  Parameters: int val
   Returns: std::shared_ptr<AVLNode>
 */
-std::shared_ptr<AVLNode> AVLTree::search(std::shared_ptr<AVLNode> n, int val){
-  if (n != nullptr) {
+std::shared_ptr<AVLNode> AVLTree::fingerSearch(int val){
+  AVL_STAT(searches);
+  AVLNode* n = climbFromFinger(val);
+  if (n == nullptr) {
+    return nullptr;
+  }
+  const std::shared_ptr<AVLNode>* slot = &slotOf(n);
+  while (n != nullptr) {
+    AVL_STAT(nodesVisited);
+    AVL_STAT(comparisons);
     if (n->value == val) {
-      return n;
-    } else if (n->value < val) {
-        return search(n->right,val);
-      } else {
-          return search(n->left,val);
-        }
+      finger = n;
+      break;
+    }
+    AVL_STAT(comparisons);
+    slot = (n->value < val) ? &n->right : &n->left;
+    n = slot->get();
   }
-
-  return nullptr;
+  return (n == nullptr) ? nullptr : *slot;
 }
 
 /*Description: Function returns pointer to node of AVLTree containing 
@@ -115,22 +257,176 @@ std::shared_ptr<AVLNode> AVLTree::maximum(std::shared_ptr<AVLNode> n){
 }
 
 
-// int getHeight(std::shared_ptr<AVLNode> n){
-//   // You are not required to implement this function though it may be useful
-//   return -1;
-// }
+/*Description: Function returns height of n, or -1 for an empty subtree.
+  Parameters: const std::shared_ptr<AVLNode> &n
+  Returns: int
+*/
+int AVLTree::getHeight(const std::shared_ptr<AVLNode> &n){
+  if (n == nullptr) {
+    return -1;
+  }
+  return n->height;
+}
 
-// int getBalanceFactor(std::shared_ptr<AVLNode> n){
-//   // You are not required to implement this function though it may be useful
-//   return -99;
-// }
+/*Description: Function returns height of right subtree of n minus height
+  of left subtree. The balance factor is not stored in AVLNode.
+  Parameters: const std::shared_ptr<AVLNode> &n
+  Returns: int
+*/
+int AVLTree::getBalanceFactor(const std::shared_ptr<AVLNode> &n){
+  return getHeight(n->right) - getHeight(n->left);
+}
+
+/*Description: Function returns number of values in subtree rooted at n,
+  counting every copy. Returns 0 for an empty subtree.
+  Parameters: const std::shared_ptr<AVLNode> &n
+  Returns: int
+*/
+int AVLTree::getSubtreeSize(const std::shared_ptr<AVLNode> &n){
+  if (n == nullptr) {
+    return 0;
+  }
+  return n->subtreeSize;
+}
+
+/*Description: Function recomputes subtree size of n from its children.
+  Must be called whenever the children of n change.
+  Parameters: const std::shared_ptr<AVLNode> &n
+  Returns: void
+*/
+void AVLTree::updateSubtreeSize(const std::shared_ptr<AVLNode> &n){
+  n->subtreeSize = getSubtreeSize(n->left) + getSubtreeSize(n->right) + n->count;
+}
+
+/*Description: Function returns pointer to node holding the k-th smallest
+  value of AVLTree, counting from 0 and counting every copy in multiset
+  mode. Returns nullptr if k is out of range. Runs in O(log n) using
+  subtree sizes.
+  Parameters: int k
+  Returns: std::shared_ptr<AVLNode>
+*/
+std::shared_ptr<AVLNode> AVLTree::select(int k){
+  if (k < 0 || k >= size) {
+    return nullptr;
+  }
+
+  std::shared_ptr<AVLNode> n = root;
+  while (n != nullptr) {
+    int leftSize = getSubtreeSize(n->left);
+    if (k < leftSize) {
+      n = n->left;
+    } else if (k >= leftSize + n->count) {
+      k = k - leftSize - n->count;
+      n = n->right;
+    } else {
+      return n;
+    }
+  }
+  return nullptr;
+}
+
+/*Description: Function returns number of values in AVLTree strictly less
+  than val. If val is in the tree this is its 0 based position in order.
+  Parameters: int val
+  Returns: int
+*/
+int AVLTree::rank(int val){
+  return countBelow(val, false);
+}
+
+/*Description: Function returns number of values v in AVLTree with
+  lo <= v <= hi.
+  Parameters: int lo, int hi
+  Returns: int
+*/
+int AVLTree::countInRange(int lo, int hi){
+  if (lo > hi) {
+    return 0;
+  }
+  return countBelow(hi, true) - countBelow(lo, false);
+}
+
+/*Description: Function counts values less than val, or less than or equal
+  to val if inclusive is true, by descending a single root to leaf path.
+  Parameters: int val, bool inclusive
+  Returns: int
+*/
+int AVLTree::countBelow(int val, bool inclusive){
+  int count = 0;
+  std::shared_ptr<AVLNode> n = root;
+  while (n != nullptr) {
+    if (n->value < val || (inclusive && n->value == val)) {
+      count = count + getSubtreeSize(n->left) + n->count;
+      n = n->right;
+    } else {
+      n = n->left;
+    }
+  }
+  return count;
+}
+
+/*Description: Function returns iterator to smallest value of AVLTree, or
+  end() if the tree is empty.
+  Parameters: N/A
+  Returns: AVLTreeIterator
+*/
+AVLTreeIterator AVLTree::begin(){
+  return AVLTreeIterator(minimum().get(), this);
+}
+
+/*Description: Function returns past-the-end iterator of AVLTree.
+  Parameters: N/A
+  Returns: AVLTreeIterator
+*/
+AVLTreeIterator AVLTree::end(){
+  return AVLTreeIterator(nullptr, this);
+}
+
+/*Description: Function returns iterator to first value not less than val,
+  or end() if there is none.
+  Parameters: int val
+  Returns: AVLTreeIterator
+*/
+AVLTreeIterator AVLTree::lowerBound(int val){
+  AVLNode* n = root.get();
+  AVLNode* candidate = nullptr;
+  while (n != nullptr) {
+    if (n->value < val) {
+      n = n->right.get();
+    } else {
+      candidate = n;
+      n = n->left.get();
+    }
+  }
+  return AVLTreeIterator(candidate, this);
+}
+
+/*Description: Function returns iterator to first value greater than val,
+  or end() if there is none.
+  Parameters: int val
+  Returns: AVLTreeIterator
+*/
+AVLTreeIterator AVLTree::upperBound(int val){
+  AVLNode* n = root.get();
+  AVLNode* candidate = nullptr;
+  while (n != nullptr) {
+    if (n->value <= val) {
+      n = n->right.get();
+    } else {
+      candidate = n;
+      n = n->left.get();
+    }
+  }
+  return AVLTreeIterator(candidate, this);
+}
 
 /*Description: Function calls insertValue(std::shared_ptr<AVLNode> n, int val).
   Parameters: N/A
   Returns: N/A
 */
 void AVLTree::insertValue(int val){
-  insertValue(root,val);
+  root = insertValue(root,val);
+  root->parent = nullptr;
 }
 
 /*Description: Function inserts node of given value into AVLTree. Function
@@ -142,63 +438,171 @@ std::shared_ptr<AVLNode> AVLTree::insertValue(std::shared_ptr<AVLNode> n, int va
   //Finds appropriate empty leaf to insert node into or skipped
   // if value already has a node.
   if (root == nullptr) {
-    root = std::shared_ptr<AVLNode>(new AVLNode(val));
+    root = std::make_shared<AVLNode>(val);
+    AVL_STAT(allocations);
     size = size + 1;
     return root;
-  } else if (n->value < val) {
+  }
+
+  AVL_STAT(nodesVisited);
+  AVL_STAT_ADD(counters, comparisons, (n->value < val) ? 1 : 2);
+  if (n->value < val) {
       if (n->right == nullptr) {
-        n->right = std::shared_ptr<AVLNode>(new AVLNode(val));
-        n->right->parent = n;
+        n->right = std::make_shared<AVLNode>(val);
+        AVL_STAT(allocations);
+        n->right->parent = n.get();
         size = size + 1;       
       } else {
           n->right = insertValue(n->right,val);
         }
     } else if (n->value > val) {
         if (n->left == nullptr) {
-          n->left = std::shared_ptr<AVLNode>(new AVLNode(val));
-          n->left->parent = n;
+          n->left = std::make_shared<AVLNode>(val);
+          AVL_STAT(allocations);
+          n->left->parent = n.get();
           size = size + 1;
         } else {
             n->left = insertValue(n->left,val);
           }
-      }
-
-  //update height of n
-  if (n->right != nullptr && n->left != nullptr) {
-    n->height = max(n->right->height, n->left->height) + 1;
-  } else if (n->right == nullptr && n->left == nullptr) {
-      n->height = 0;
-    } else if (n->right == nullptr) {
-        n->height = (n->left->height) + 1;
-      } else {
-          n->height = (n->right->height) + 1;
-        }         
-
-  //update balance factor of n
-  if (n->right != nullptr && n->left != nullptr) {
-    n->balanceFactor = (n->right->height) - (n->left->height);     
-  } else if (n->right == nullptr && n->left == nullptr) {
-      n->balanceFactor = 0;
-    } else if (n->right == nullptr) { 
-        n->balanceFactor = -1 - (n->left->height);
-      } else {
-          n->balanceFactor = (n->right->height) + 1; 
+      } else if (multiset) {
+          n->count = n->count + 1;
+          size = size + 1;
         }
+
+  updateNode(n);
           
   // rebalance n
   n = rebalance(n);  
-  while (root->parent != nullptr) {
-    root = root->parent;
-  }  
   return n;
 }
 
+/*Description: Function inserts val starting from the finger, the node
+  last found or inserted by fingerSearch or fingerInsert, and moves the
+  finger to val. The new leaf is found by climbing from the finger then
+  descending, and the tree is rebalanced bottom up through parent links,
+  stopping once a subtree's height is unchanged. Above that point only
+  subtree sizes change, which costs one increment per ancestor. Finding
+  the place costs O(log d) for a key d values from the finger, but the
+  size increments run all the way to the root, so an insert stays
+  O(log n); the saving is in comparisons and cache misses, not in the
+  bound. Keys arriving in increasing order, such as timestamps, are each
+  placed next to the previous one without comparisons from the root.
+  Parameters: int val
+  Returns: void
+*/
+void AVLTree::fingerInsert(int val){
+  AVLNode* n = climbFromFinger(val);
+  if (n == nullptr) {
+    root = std::make_shared<AVLNode>(val);
+    AVL_STAT(allocations);
+    size = 1;
+    finger = root.get();
+    return;
+  }
+
+  AVLNode* parent = nullptr;
+  while (n != nullptr) {
+    AVL_STAT(nodesVisited);
+    AVL_STAT_ADD(counters, comparisons, (n->value == val) ? 1 : 2);
+    if (n->value == val) {
+      finger = n;
+      if (multiset) {
+        n->count = n->count + 1;
+        size = size + 1;
+        for (AVLNode* up = n; up != nullptr; up = up->parent) {
+          up->subtreeSize = up->subtreeSize + 1;
+        }
+      }
+      return;
+    }
+    parent = n;
+    n = (n->value < val) ? n->right.get() : n->left.get();
+  }
+
+  std::shared_ptr<AVLNode> &link = (parent->value < val) ? parent->right : parent->left;
+  link = std::make_shared<AVLNode>(val);
+  AVL_STAT(allocations);
+  link->parent = parent;
+  finger = link.get();
+  size = size + 1;
+
+  bool heightChanged = true;
+  while (parent != nullptr) {
+    AVLNode* up = parent->parent;
+    if (heightChanged) {
+      int before = parent->height;
+      std::shared_ptr<AVLNode> &slot = slotOf(parent);
+      updateNode(slot);
+      slot = rebalance(slot);
+      heightChanged = (slot->height != before);
+    } else {
+      parent->subtreeSize = parent->subtreeSize + 1;
+    }
+    parent = up;
+  }
+}
+
 /*Description: Function calls deleteValue(std::shared_ptr<AVLNode> n, int val).
   Parameters: int val
   Returns: void
 */
 void AVLTree::deleteValue(int val){
-  deleteValue(root, val);
+  finger = nullptr;
+  root = deleteValue(root, val);
+  if (root != nullptr) {
+    root->parent = nullptr;
+  }
+}
+
+/*Description: Function returns the lowest ancestor of the finger, or the
+  finger itself, whose subtree covers val; the root if there is no
+  finger. When val is greater than the finger every ancestor's subtree
+  already extends below val, so the climb stops at the first node that
+  is a left child of a parent greater than val; when val is smaller it
+  stops at the first right child of a parent smaller than val. A climb
+  longer than half the tree height means val is roughly sqrt(n) or more
+  values away, where descending from the root is no worse than O(log d),
+  so the climb gives up and returns the root.
+  Parameters: int val
+  Returns: AVLNode*
+*/
+AVLNode* AVLTree::climbFromFinger(int val){
+  AVLNode* n = finger;
+  if (n == nullptr) {
+    return root.get();
+  }
+  int steps = 0;
+  int limit = root->height / 2;
+  if (n->value < val) {
+    while (n->parent != nullptr && !(n->parent->left.get() == n && val < n->parent->value)) {
+      AVL_STAT(nodesVisited);
+      n = n->parent;
+      if (++steps > limit) {
+        return root.get();
+      }
+    }
+  } else if (val < n->value) {
+    while (n->parent != nullptr && !(n->parent->right.get() == n && n->parent->value < val)) {
+      AVL_STAT(nodesVisited);
+      n = n->parent;
+      if (++steps > limit) {
+        return root.get();
+      }
+    }
+  }
+  return n;
+}
+
+/*Description: Function returns the owning pointer that holds n, either
+  root or a child link of n's parent.
+  Parameters: AVLNode* n
+  Returns: std::shared_ptr<AVLNode>&
+*/
+std::shared_ptr<AVLNode>& AVLTree::slotOf(AVLNode* n){
+  if (n->parent == nullptr) {
+    return root;
+  }
+  return (n->parent->left.get() == n) ? n->parent->left : n->parent->right;
 }
 
 /*Description: Function returns pointer to node with minimum value of
@@ -221,10 +625,16 @@ std::shared_ptr<AVLNode> deleteValueMinimum(std::shared_ptr<AVLNode> n) {
 std::shared_ptr<AVLNode> AVLTree::deleteValue(std::shared_ptr<AVLNode> n, int val){
   // Search for node containing value to be deleted.
   if (n != nullptr) {
+    AVL_STAT(nodesVisited);
+    AVL_STAT_ADD(counters, comparisons, (val < n->value) ? 1 : 2);
     if (val < n->value) {
       n->left = deleteValue(n->left, val);
     } else if (val > n->value) {
         n->right = deleteValue(n->right, val);
+      } else if (n->count > 1) {
+          // Only one copy goes, the node stays.
+          n->count = n->count - 1;
+          size = size - 1;
       } else if (n->left == nullptr && n->right == nullptr) {
         // Node to be deleted has no children. Contains 
         // two cases for node being root or not root.
@@ -291,7 +701,7 @@ std::shared_ptr<AVLNode> AVLTree::deleteValue(std::shared_ptr<AVLNode> n, int va
                 n->value = minimumInRightTree->value;
                 if (n == root && minimumInRightTree == n->right) {
                   if (root->left !=nullptr) {
-                    root->left->parent = root->right;
+                    root->left->parent = root->right.get();
                     root->right->left = root->left;
                   }
                   
@@ -300,6 +710,10 @@ std::shared_ptr<AVLNode> AVLTree::deleteValue(std::shared_ptr<AVLNode> n, int va
                   n = root;
                   size = size - 1;
                 } else {
+                    // n takes over every copy of the minimum, so its node
+                    // must be removed outright
+                    n->count = minimumInRightTree->count;
+                    minimumInRightTree->count = 1;
                     n->right = deleteValue(n->right, n->value);
                   }              
               }  
@@ -309,27 +723,11 @@ std::shared_ptr<AVLNode> AVLTree::deleteValue(std::shared_ptr<AVLNode> n, int va
     return n;
   }
 
-  // update heights and balance factors of n
-  if (n->left == nullptr && n->right == nullptr) {
-    n->height = 0;
-    n->balanceFactor = 0;
-  } else if (n->left == nullptr) {
-      n->height = n->right->height + 1;
-      n->balanceFactor = n->right->height + 1;
-    } else if (n->right == nullptr) {
-        n->height = n->left->height + 1;
-        n->balanceFactor = -1 - n->left->height; 
-      } else {
-          n->height = max(n->left->height, n->right->height) + 1;
-          n->balanceFactor = n->right->height - n->left->height;
-        }
+  // children of n may have been spliced out above, updateNode points
+  // their replacements back at n
+  updateNode(n);
  
   n = rebalance(n);
-  
-  // update potential root changes
-  while (root->parent != nullptr) {
-    root = root->parent;
-  }  
   return n;
 }
 
@@ -343,17 +741,16 @@ std::shared_ptr<AVLNode> AVLTree::rebalance(std::shared_ptr<AVLNode> n){
     return n;
   }
   
-  if (n->balanceFactor == 2 && n->right->balanceFactor >= 0) {
+  int balanceFactor = getBalanceFactor(n);
+  if (balanceFactor == 2 && getBalanceFactor(n->right) >= 0) {
     return rotateLeft(n);
-  } else if (n->balanceFactor == 2 && n->right->balanceFactor < 0) {
+  } else if (balanceFactor == 2) {
       return rotateRightLeft(n);
-    } else if (n->balanceFactor == -2 && n->left->balanceFactor <= 0) {
+    } else if (balanceFactor == -2 && getBalanceFactor(n->left) <= 0) {
         return rotateRight(n);
-      } else if (n->balanceFactor == -2 && n->left->balanceFactor > 0) {
+      } else if (balanceFactor == -2) {
           return rotateLeftRight(n);
-        } else {
-            return n;
-          }
+        }
 
   return n;
 }
@@ -364,58 +761,14 @@ std::shared_ptr<AVLNode> AVLTree::rebalance(std::shared_ptr<AVLNode> n){
   Returns: std::shared_ptr<AVLNode>
 */
 std::shared_ptr<AVLNode> AVLTree::rotateLeft(std::shared_ptr<AVLNode> n){
+  AVL_STAT(rotationsLeft);
   std::shared_ptr<AVLNode> temp = n->right;
   n->right = temp->left;
-
-  if (n->right != nullptr) {
-    n->right->parent = n;
-  }
-
-  // update height and balance factor of n
-  if (n->right == nullptr && n->left == nullptr) {
-    n->height = 0;
-    n->balanceFactor = 0;
-  } else if (n->right == nullptr) {
-      n->height = n->left->height + 1;
-      n->balanceFactor = -1 - n->left->height;
-    } else if (n->left == nullptr) {
-        n->height = n->right->height + 1;
-        n->balanceFactor = n->right->height + 1;
-      } else {
-          n->height = max(n->right->height, n->left->height) + 1;
-          n->balanceFactor = n->right->height - n->left->height;
-        }
+  updateNode(n);
 
   temp->left = n;
   temp->parent = n->parent;
-  n->parent = temp;
-
-  if (temp->parent != nullptr) {
-    if (temp->parent->right != nullptr) {
-      if (temp->parent->right == temp) {
-        temp->parent->right = temp;
-      }
-    } else if (temp->parent->left !=nullptr) {
-        if (temp->parent->left == temp) {
-          temp->parent->left = temp;
-        }
-      }
-  }
-
-  // update height and balance factor temp
-  if (temp->right == nullptr && temp->left == nullptr) {
-    temp->height == 0;
-    temp->balanceFactor = 0;
-  } else if (temp->right == nullptr) {
-      temp->height = temp->left->height + 1;
-      temp->balanceFactor = -1 - temp->left->height;
-    } else if (temp->left == nullptr) {
-        temp->height = temp->right->height + 1;
-        temp->balanceFactor = temp->right->height + 1;
-      } else {
-          temp->height = max(temp->right->height, temp->left->height) + 1;
-          temp->balanceFactor = temp->right->height - temp->left->height;
-        }
+  updateNode(temp);
 
   return temp;
 }
@@ -429,57 +782,14 @@ std::shared_ptr<AVLNode> AVLTree::rotateLeft(std::shared_ptr<AVLNode> n){
   Returns: std::shared_ptr<AVLNode>
 */
 std::shared_ptr<AVLNode> AVLTree::rotateRight(std::shared_ptr<AVLNode> n){
+  AVL_STAT(rotationsRight);
   std::shared_ptr<AVLNode> temp = n->left;
   n->left = temp->right;
-  if (n->left != nullptr) {
-    n->left->parent = n;
-  }
+  updateNode(n);
 
-  // update height and balance factor of n
-  if (n->right == nullptr && n->left == nullptr) {
-    n->height = 0;
-    n->balanceFactor = 0;
-  } else if (n->right == nullptr) {
-      n->height = n->left->height + 1;
-      n->balanceFactor = -1 - n->left->height;
-    } else if (n->left == nullptr) {
-        n->height = n->right->height + 1;
-        n->balanceFactor = n->right->height + 1;
-      } else {
-          n->height = max(n->right->height, n->left->height) + 1;
-          n->balanceFactor = n->right->height - n->left->height;
-        }
-  
   temp->right = n;
   temp->parent = n->parent;
-  n->parent = temp;
-  
-  if (temp->parent != nullptr) {
-    if (temp->parent->right !=nullptr) {
-      if (temp->parent->right == temp) {
-        temp->parent->right = temp;
-      }
-    } else if (temp->parent->left !=nullptr) {
-        if (temp->parent->left == temp) {
-          temp->parent->left = temp;
-        }
-      }
-  }
-
-  // update height and balance factor of temp
-  if (temp->right == nullptr && temp->left == nullptr) {
-    temp->height == 0;
-    temp->balanceFactor = 0;
-  } else if (temp->right == nullptr) {
-      temp->height = temp->left->height + 1;
-      temp->balanceFactor = -1 - temp->left->height;
-    } else if (temp->left == nullptr) {
-        temp->height = temp->right->height + 1;
-        temp->balanceFactor = temp->right->height + 1;
-      } else {
-          temp->height = max(temp->right->height, temp->left->height) + 1;
-          temp->balanceFactor = temp->right->height - temp->left->height;
-        }   
+  updateNode(temp);
 
   return temp;
 }
@@ -490,85 +800,19 @@ std::shared_ptr<AVLNode> AVLTree::rotateRight(std::shared_ptr<AVLNode> n){
   Returns: std::shared_ptr<AVLNode>
 */
 std::shared_ptr<AVLNode> AVLTree::rotateLeftRight(std::shared_ptr<AVLNode> n){
-  //rotate left
+  AVL_STAT(rotationsLeftRight);
   std::shared_ptr<AVLNode> temp1 = n->left, temp2 = n->left->right;
-  temp1->right = temp2->left;
-
-  if (temp1->right != nullptr) {
-    temp1->right->parent = temp1;
-  }
-
-  //update height and balance factor of x
-  if (temp1->right == nullptr && temp1->left == nullptr) {
-    temp1->height = 0;
-    temp1->balanceFactor = 0;
-  } else if (temp1->right == nullptr) {
-      temp1->height = temp1->left->height + 1;
-      temp1->balanceFactor = -1 - temp1->left->height;
-    } else if (temp1->left == nullptr) {
-        temp1->height = temp1->right->height + 1;
-        temp1->balanceFactor = temp1->right->height + 1;
-      } else {
-          temp1->height = max(temp1->right->height, temp1->left->height) + 1;
-          temp1->balanceFactor = temp1->right->height - temp1->left->height;
-        }
 
-  temp2->left = temp1;
-  temp1->parent = temp2;
-  n->left = temp2;
-  temp2->parent = n;
-
-  //rotate right
+  //rotate temp1 left, then n right, leaving temp2 on top
+  temp1->right = temp2->left;
+  updateNode(temp1);
   n->left = temp2->right;
-  if (temp2->right != nullptr) {
-    temp2->right->parent = n;
-  }
-  
-  //update height and balance factor of y
-  if (n->right == nullptr && n->left == nullptr) {
-    n->height = 0;
-    n->balanceFactor = 0;
-  } else if (n->right == nullptr) {
-      n->height = n->left->height + 1;
-      n->balanceFactor = -1 - n->left->height;
-    } else if (n->left == nullptr) {
-        n->height = n->right->height + 1;
-        n->balanceFactor = n->right->height + 1;
-      } else {
-          n->height = max(n->right->height, n->left->height) + 1;
-          n->balanceFactor = n->right->height - n->left->height;
-        }
+  updateNode(n);
 
+  temp2->left = temp1;
   temp2->right = n;
   temp2->parent = n->parent;
-  n->parent = temp2;
-
-  if (temp2->parent != nullptr) {
-    if (temp2->parent->right !=nullptr) {
-      if (temp2->parent->right == temp2) {
-        temp2->parent->right = temp2;
-      }
-    } else if (temp2->parent->left !=nullptr) {
-        if (temp2->parent->left == temp2) {
-          temp2->parent->left = temp2;
-        }
-      }
-  }
-
-  //update height and balance factor of z
-  if (temp2->right == nullptr && temp2->left == nullptr) {
-    temp2->height = 0;
-    temp2->balanceFactor = 0;
-  } else if (temp2->right == nullptr) {
-      temp2->height = temp2->left->height + 1;
-      temp2->balanceFactor = -1 - temp2->left->height;
-    } else if (temp2->left == nullptr) {
-        temp2->height = temp2->right->height + 1;
-        temp2->balanceFactor = temp2->right->height - 1;
-      } else {
-          temp2->height = max(temp2->right->height, temp2->left->height) + 1;
-          temp2->balanceFactor = temp2->right->height - temp2->left->height;
-        }
+  updateNode(temp2);
 
   return temp2;
 }
@@ -579,89 +823,72 @@ std::shared_ptr<AVLNode> AVLTree::rotateLeftRight(std::shared_ptr<AVLNode> n){
   Returns: std::shared_ptr<AVLNode>
 */
 std::shared_ptr<AVLNode> AVLTree::rotateRightLeft(std::shared_ptr<AVLNode> n){
-  // rotate right
+  AVL_STAT(rotationsRightLeft);
   std::shared_ptr<AVLNode> temp1 = n->right, temp2 = n->right->left;
+
+  //rotate temp1 right, then n left, leaving temp2 on top
   temp1->left = temp2->right;
-  if (temp1->left != nullptr) {
-    temp1->left->parent = temp1;
-  }
-
-  //update height and balance factors x
-  if (temp1->right == nullptr && temp1->left == nullptr) {
-    temp1->height = 0;
-    temp1->balanceFactor = 0;
-  } else if (temp1->right == nullptr) {
-      temp1->height = temp1->left->height + 1;
-      temp1->balanceFactor = -1 - temp1->left->height;
-    } else if (temp1->left == nullptr) {
-        temp1->height = temp1->right->height + 1;
-        temp1->balanceFactor = temp1->right->height + 1;
-      } else {
-          temp1->height = max(temp1->right->height, temp1->left->height) + 1;
-          temp1->balanceFactor = temp1->right->height - temp1->left->height;
-        }
+  updateNode(temp1);
+  n->right = temp2->left;
+  updateNode(n);
 
   temp2->right = temp1;
+  temp2->left = n;
+  temp2->parent = n->parent;
+  updateNode(temp2);
 
-  temp1->parent = temp2;
-  
-  n->right = temp2;
-  temp2->parent = n;
+  return temp2;
+}
 
+/*Description: Function returns the counters gathered since construction
+  or the last resetStats() together with the current shape of the tree:
+  height, maximum and average depth of its leaves, and bytes held by its
+  nodes. Byte counts exclude allocator and reference count overhead.
+  Parameters: N/A
+  Returns: AVLTreeStats
+*/
+AVLTreeStats AVLTree::treeStats(){
+  AVLTreeStats stats = counters;
+  stats.height = getHeight(root);
+  stats.maxLeafDepth = -1;
+  stats.averageLeafDepth = 0;
+  stats.bytes = 0;
 
-  //rotate left
-  n->right = temp2->left;
-  if (temp2->left != nullptr) {
-    temp2->left->parent = n;
+  long long leaves = 0;
+  long long leafDepthSum = 0;
+  std::vector<std::pair<AVLNode*, int>> stack;
+  if (root != nullptr) {
+    stack.push_back(std::make_pair(root.get(), 0));
   }
-  
-  //update height and balance factor of y
-  if (n->right == nullptr && n->left == nullptr) {
-    n->height = 0;
-    n->balanceFactor = 0;
-  } else if (n->right == nullptr) {
-      n->height = n->left->height + 1;
-      n->balanceFactor = -1 - n->left->height;
-    } else if (n->left == nullptr) {
-        n->height = n->right->height + 1;
-        n->balanceFactor = n->right->height + 1;
-      } else {
-          n->height = max(n->right->height, n->left->height) + 1;
-          n->balanceFactor = n->right->height - n->left->height;
-        }
-
-  temp2->left = n;
-  temp2->parent = n->parent;
-  n->parent = temp2;
-  
-  if (temp2->parent != nullptr) {
-    if (temp2->parent->right !=nullptr) {
-      if (temp2->parent->right == temp2) {
-        temp2->parent->right = temp2;
-      }
-    } else if (temp2->parent->left !=nullptr) {
-        if (temp2->parent->left == temp2) {
-          temp2->parent->left = temp2;
-        }
-      }
+  while (!stack.empty()) {
+    AVLNode* n = stack.back().first;
+    int depth = stack.back().second;
+    stack.pop_back();
+    stats.bytes = stats.bytes + sizeof(AVLNode);
+    if (n->left == nullptr && n->right == nullptr) {
+      leaves = leaves + 1;
+      leafDepthSum = leafDepthSum + depth;
+      stats.maxLeafDepth = max(stats.maxLeafDepth, depth);
+    }
+    if (n->left != nullptr) {
+      stack.push_back(std::make_pair(n->left.get(), depth + 1));
+    }
+    if (n->right != nullptr) {
+      stack.push_back(std::make_pair(n->right.get(), depth + 1));
+    }
   }
-  
-  //update height and balance factor of z
-  if (temp2->right == nullptr && temp2->left == nullptr) {
-    temp2->height = 0;
-    temp2->balanceFactor = 0;
-  } else if (temp2->right == nullptr) {
-      temp2->height = temp2->left->height + 1;
-      temp2->balanceFactor = -1 - temp2->left->height;
-    } else if (temp2->left == nullptr) {
-        temp2->height = temp2->right->height + 1;
-        temp2->balanceFactor = temp2->right->height - 1;
-      } else {
-          temp2->height = max(temp2->right->height, temp2->left->height) + 1;
-          temp2->balanceFactor = temp2->right->height - temp2->left->height;
-        }
+  if (leaves > 0) {
+    stats.averageLeafDepth = (double)leafDepthSum / leaves;
+  }
+  return stats;
+}
 
-  return temp2;
+/*Description: Function sets all counters reported by treeStats() to zero.
+  Parameters: N/A
+  Returns: void
+*/
+void AVLTree::resetStats(){
+  counters = AVLTreeStats();
 }
 
 /*Description: Function outputs preorder traversal of given BST to console.
@@ -703,3 +930,695 @@ void AVLTree::postOrder(std::shared_ptr<AVLNode> n, vector<std::shared_ptr<AVLNo
   }
 }
 
+
+
+/*Description: Function builds a perfectly balanced AVLTree from values
+  sorted in ascending order in O(n). All nodes are allocated in one
+  contiguous block, so the nodes of the new tree sit next to each other
+  in memory. Repeated values are stored once.
+  Parameters: const std::vector<int> &values
+  Returns: AVLTree
+*/
+AVLTree AVLTree::buildFromSorted(const std::vector<int> &values){
+  AVLTree T;
+  if (values.empty()) {
+    return T;
+  }
+
+  if (std::adjacent_find(values.begin(), values.end()) != values.end()) {
+    std::vector<int> distinct;
+    distinct.reserve(values.size());
+    std::unique_copy(values.begin(), values.end(), std::back_inserter(distinct));
+    return buildFromSorted(distinct);
+  }
+
+  T.root = buildFromSorted(values, 0, values.size() - 1);
+  T.size = values.size();
+  AVL_STAT_ADD(T.counters, allocations, T.size);
+  return T;
+}
+
+/*Description: Function sorts values in parallel then builds a balanced
+  AVLTree from them with buildFromSorted.
+  Parameters: std::vector<int> values
+  Returns: AVLTree
+*/
+AVLTree AVLTree::fromUnsorted(std::vector<int> values){
+  parallelSort(values, 0, values.size(), std::thread::hardware_concurrency());
+  return buildFromSorted(values);
+}
+
+/*Description: Function builds a balanced subtree holding values[lo..hi]
+  from a new arena sized for it and returns its root. Every node keeps
+  the arena alive through its control block, and the arena is released
+  with the last of them.
+  Parameters: const std::vector<int> &values, int lo, int hi
+  Returns: std::shared_ptr<AVLNode>
+*/
+std::shared_ptr<AVLNode> AVLTree::buildFromSorted(const std::vector<int> &values, int lo, int hi){
+  if (lo > hi) {
+    return nullptr;
+  }
+  AVLNodeAllocator<AVLNode> allocator(new AVLNodeArena(hi - lo + 1));
+  return linkFromSorted(allocator, values, lo, hi);
+}
+
+/*Description: Function links values[lo..hi] into a balanced subtree and
+  returns its root. The left subtree is allocated before its root and
+  the right subtree after, so the arena holds the nodes in ascending
+  order.
+  Parameters: AVLNodeAllocator<AVLNode> &allocator,
+  const std::vector<int> &values, int lo, int hi
+  Returns: std::shared_ptr<AVLNode>
+*/
+std::shared_ptr<AVLNode> AVLTree::linkFromSorted(AVLNodeAllocator<AVLNode> &allocator,
+    const std::vector<int> &values, int lo, int hi){
+  if (lo > hi) {
+    return nullptr;
+  }
+
+  int mid = lo + (hi - lo) / 2;
+  std::shared_ptr<AVLNode> left = linkFromSorted(allocator, values, lo, mid - 1);
+  std::shared_ptr<AVLNode> n = std::allocate_shared<AVLNode>(allocator, values[mid]);
+  n->left = left;
+  n->right = linkFromSorted(allocator, values, mid + 1, hi);
+  updateNode(n);
+  return n;
+}
+
+/*Description: Function sorts values[lo, hi) using up to threads threads.
+  The range is halved, each half sorted on its own thread and the halves
+  merged. Small ranges are sorted sequentially.
+  Parameters: std::vector<int> &values, size_t lo, size_t hi,
+  unsigned threads
+  Returns: void
+*/
+void AVLTree::parallelSort(std::vector<int> &values, size_t lo, size_t hi, unsigned threads){
+  const size_t grainSize = 1 << 16;
+  if (threads < 2 || hi - lo <= grainSize) {
+    std::sort(values.begin() + lo, values.begin() + hi);
+    return;
+  }
+
+  size_t mid = lo + (hi - lo) / 2;
+  std::thread leftHalf(parallelSort, std::ref(values), lo, mid, threads / 2);
+  parallelSort(values, mid, hi, threads - threads / 2);
+  leftHalf.join();
+  std::inplace_merge(values.begin() + lo, values.begin() + mid, values.begin() + hi);
+}
+
+/*Description: Function joins trees L and R around value k, where every
+  value of L is less than k and every value of R is greater than k. Runs
+  in O(|height(L) - height(R)| + 1). L and R are left empty. If the
+  ordering does not hold the trees are merged with unionWith instead.
+  Parameters: AVLTree &L, int k, AVLTree &R
+  Returns: AVLTree
+*/
+AVLTree AVLTree::join(AVLTree &L, int k, AVLTree &R){
+  AVLTree T;
+  if ((L.root != nullptr && L.maximum()->value >= k) ||
+      (R.root != nullptr && R.minimum()->value <= k)) {
+    T.unionWith(L);
+    T.unionWith(R);
+    T.insertValue(k);
+    return T;
+  }
+
+  T.root = T.joinNodes(L.root, std::make_shared<AVLNode>(k), R.root);
+  AVL_STAT_ADD(T.counters, allocations, 1);
+  T.size = getSubtreeSize(T.root);
+  L.root = nullptr;
+  L.size = 0;
+  L.finger = nullptr;
+  R.root = nullptr;
+  R.size = 0;
+  R.finger = nullptr;
+  return T;
+}
+
+/*Description: Function splits T into L holding the values less than k and
+  R holding the values greater than k in O(log n). T is left empty.
+  Parameters: AVLTree &T, int k, AVLTree &L, AVLTree &R
+  Returns: bool - true if k was in T
+*/
+bool AVLTree::split(AVLTree &T, int k, AVLTree &L, AVLTree &R){
+  std::shared_ptr<AVLNode> n = T.root;
+  T.root = nullptr;
+  T.size = 0;
+  T.finger = nullptr;
+
+  std::shared_ptr<AVLNode> left, right;
+  bool found = false;
+  T.splitNode(n, k, left, found, right);
+  L.root = left;
+  L.size = getSubtreeSize(left);
+  L.finger = nullptr;
+  R.root = right;
+  R.size = getSubtreeSize(right);
+  R.finger = nullptr;
+  return found;
+}
+
+/*Description: Function adds every value of other to AVLTree. Uses the
+  join based union, O(m log(n/m + 1)) for trees of sizes m <= n. The
+  nodes of other are moved into this tree, so other is left empty.
+  Parameters: AVLTree &other
+  Returns: void
+*/
+void AVLTree::unionWith(AVLTree &other){
+  if (&other == this) {
+    return;
+  }
+  root = unionNodes(root, other.root, parallelism);
+  size = getSubtreeSize(root);
+  finger = nullptr;
+  other.root = nullptr;
+  other.size = 0;
+  other.finger = nullptr;
+}
+
+/*Description: Function removes every value of AVLTree not in other. Uses
+  the join based intersection. other is left empty.
+  Parameters: AVLTree &other
+  Returns: void
+*/
+void AVLTree::intersect(AVLTree &other){
+  if (&other == this) {
+    return;
+  }
+  root = intersectNodes(root, other.root, parallelism);
+  size = getSubtreeSize(root);
+  finger = nullptr;
+  other.root = nullptr;
+  other.size = 0;
+  other.finger = nullptr;
+}
+
+/*Description: Function removes every value of other from AVLTree. Uses
+  the join based difference. other is left empty.
+  Parameters: AVLTree &other
+  Returns: void
+*/
+void AVLTree::difference(AVLTree &other){
+  finger = nullptr;
+  if (&other == this) {
+    root = nullptr;
+    size = 0;
+    return;
+  }
+  root = differenceNodes(root, other.root, parallelism);
+  size = getSubtreeSize(root);
+  other.root = nullptr;
+  other.size = 0;
+  other.finger = nullptr;
+}
+
+/*Description: Function returns an immutable copy of AVLTree laid out for
+  fast read only lookups. Later updates to AVLTree do not affect it.
+  Parameters: N/A
+  Returns: FrozenAVLTree
+*/
+FrozenAVLTree AVLTree::freeze(){
+  std::vector<int> values;
+  values.reserve(size);
+  for (AVLTreeIterator it = begin(); it != end(); ++it) {
+    values.push_back(it->value);
+  }
+  return FrozenAVLTree(values);
+}
+
+// Saved trees start with this tag followed by the number of values as a
+// 64 bit integer, then the values in ascending order as native ints.
+static const char savedKeysTag[8] = {'A', 'V', 'L', 'K', 'E', 'Y', 'S', '1'};
+
+// Values written per call while saving.
+static const int saveChunk = 1 << 16;
+
+/*Description: Function writes the distinct values of AVLTree to the file
+  at path as a sorted array, 4 bytes per value. The shape is not stored
+  since load rebuilds a perfectly balanced tree from the sorted values.
+  Parameters: const std::string &path
+  Returns: bool - false if the file could not be written
+*/
+bool AVLTree::save(const std::string &path){
+  std::ofstream out(path.c_str(), std::ios::binary | std::ios::trunc);
+  uint64_t count = 0;
+  out.write(savedKeysTag, sizeof(savedKeysTag));
+  out.write(reinterpret_cast<const char*>(&count), sizeof(count));
+
+  std::vector<int> chunk;
+  chunk.reserve(saveChunk);
+  for (AVLTreeIterator it = begin(); it != end(); ++it) {
+    chunk.push_back(it->value);
+    count = count + 1;
+    if (chunk.size() == saveChunk) {
+      out.write(reinterpret_cast<const char*>(chunk.data()), chunk.size() * sizeof(int));
+      chunk.clear();
+    }
+  }
+  out.write(reinterpret_cast<const char*>(chunk.data()), chunk.size() * sizeof(int));
+
+  // The number of distinct values is only known after the walk.
+  out.seekp(sizeof(savedKeysTag));
+  out.write(reinterpret_cast<const char*>(&count), sizeof(count));
+  out.close();
+  return !out.fail();
+}
+
+/*Description: Function replaces T with the tree saved at path. The
+  values are read with one call and the tree is rebuilt with
+  buildFromSorted in O(n), with no searches or rotations. T is left
+  unchanged if the file is missing, not sorted, or its length does not
+  match the count in its header.
+  Parameters: const std::string &path, AVLTree &T
+  Returns: bool - true if T was loaded
+*/
+bool AVLTree::load(const std::string &path, AVLTree &T){
+  std::ifstream in(path.c_str(), std::ios::binary);
+  char tag[sizeof(savedKeysTag)];
+  uint64_t count = 0;
+  in.read(tag, sizeof(tag));
+  in.read(reinterpret_cast<char*>(&count), sizeof(count));
+  if (!in || std::memcmp(tag, savedKeysTag, sizeof(tag)) != 0 || count > INT_MAX) {
+    return false;
+  }
+
+  // Only trust count once the file is known to hold exactly that many
+  // values, so a corrupt header cannot force a huge allocation.
+  if (bytesRemaining(in) != (int64_t)(count * sizeof(int))) {
+    return false;
+  }
+
+  std::vector<int> values(count);
+  in.read(reinterpret_cast<char*>(values.data()), count * sizeof(int));
+  if (!in) {
+    return false;
+  }
+  for (size_t i = 1; i < values.size(); i++) {
+    if (values[i - 1] >= values[i]) {
+      return false;
+    }
+  }
+
+  T.root = values.empty() ? nullptr : buildFromSorted(values, 0, values.size() - 1);
+  T.size = values.size();
+  T.finger = nullptr;
+  AVL_STAT_ADD(T.counters, allocations, T.size);
+  return true;
+}
+
+/*Description: Function sets how many threads the bulk set operations and
+  batch updates may use. 1 (the default) runs them sequentially. The two
+  halves of each join based recursion are independent, so when more than
+  one thread is allowed one half is handed to a new thread, with the
+  budget shared out by the size of each half, until the budget is spent.
+  A half under parallelGrainSize nodes is not forked off; both halves
+  then run inline with the whole budget.
+  Parameters: unsigned threads
+  Returns: void
+*/
+void AVLTree::setParallelism(unsigned threads){
+  if (threads < 1) {
+    threads = 1;
+  }
+  parallelism = threads;
+}
+
+/*Description: Function inserts a batch of values sorted in ascending
+  order. The batch is built into a balanced tree in O(m) and merged with
+  unionWith rather than inserted one value at a time.
+  Parameters: const std::vector<int> &sortedValues
+  Returns: void
+*/
+void AVLTree::insertBatch(const std::vector<int> &sortedValues){
+  AVLTree batch = buildFromSorted(sortedValues);
+  AVL_STAT_ADD(counters, allocations, batch.size);
+  unionWith(batch);
+}
+
+/*Description: Function deletes a batch of values sorted in ascending
+  order using difference.
+  Parameters: const std::vector<int> &sortedValues
+  Returns: void
+*/
+void AVLTree::deleteBatch(const std::vector<int> &sortedValues){
+  AVLTree batch = buildFromSorted(sortedValues);
+  AVL_STAT_ADD(counters, allocations, batch.size);
+  difference(batch);
+}
+
+/*Description: Function applies a batch of inserts and deletes sorted by
+  value in one pass down the tree instead of one root to leaf walk per
+  update. Updates to the same value take effect in batch order. Runs on
+  up to parallelism threads.
+  Parameters: const std::vector<AVLTreeUpdate> &sortedUpdates
+  Returns: void
+*/
+void AVLTree::applyBatch(const std::vector<AVLTreeUpdate> &sortedUpdates){
+  root = applyNodes(root, sortedUpdates, 0, sortedUpdates.size(), parallelism);
+  size = getSubtreeSize(root);
+  finger = nullptr;
+}
+
+/*Description: Function removes every value v with lo <= v <= hi and
+  returns how many were removed, counting every copy. The tree is split
+  at lo and at hi and the outer parts are joined, so rebalancing is
+  limited to the split and join paths, O(log n) in all, and the k nodes
+  in range are dropped as one detached subtree after the tree is whole
+  again.
+  Parameters: int lo, int hi
+  Returns: int
+*/
+int AVLTree::eraseRange(int lo, int hi){
+  if (lo > hi || root == nullptr) {
+    return 0;
+  }
+
+  std::shared_ptr<AVLNode> below, rest, inRange, above;
+  bool found;
+  splitNode(root, lo, below, found, rest);
+  root = nullptr;
+  splitNode(rest, hi, inRange, found, above);
+  rest = nullptr;
+  root = joinNodes(below, above);
+
+  int erased = size - getSubtreeSize(root);
+  size = getSubtreeSize(root);
+  finger = nullptr;
+  return erased;
+}
+
+/*Description: Function removes every value less than x and returns how
+  many were removed, counting every copy. See eraseRange.
+  Parameters: int x
+  Returns: int
+*/
+int AVLTree::eraseBelow(int x){
+  if (x == INT_MIN) {
+    return 0;
+  }
+  return eraseRange(INT_MIN, x - 1);
+}
+
+/*Description: Function recomputes height and subtree size
+  of n from its children and points the children back at n.
+  Parameters: const std::shared_ptr<AVLNode> &n
+  Returns: void
+*/
+void AVLTree::updateNode(const std::shared_ptr<AVLNode> &n){
+  int leftHeight = getHeight(n->left);
+  int rightHeight = getHeight(n->right);
+  n->height = max(leftHeight, rightHeight) + 1;
+  updateSubtreeSize(n);
+  if (n->left != nullptr) {
+    n->left->parent = n.get();
+  }
+  if (n->right != nullptr) {
+    n->right->parent = n.get();
+  }
+}
+
+/*Description: Function returns root of a tree holding the values of l,
+  the detached node mid and the values of r, where l < mid < r.
+  Parameters: std::shared_ptr<AVLNode> l, std::shared_ptr<AVLNode> mid,
+  std::shared_ptr<AVLNode> r
+  Returns: std::shared_ptr<AVLNode>
+*/
+std::shared_ptr<AVLNode> AVLTree::joinNodes(std::shared_ptr<AVLNode> l, std::shared_ptr<AVLNode> mid, std::shared_ptr<AVLNode> r){
+  std::shared_ptr<AVLNode> joined;
+  if (getHeight(l) > getHeight(r) + 1) {
+    joined = joinRight(l, mid, r);
+  } else if (getHeight(r) > getHeight(l) + 1) {
+    joined = joinLeft(l, mid, r);
+  } else {
+    mid->left = l;
+    mid->right = r;
+    updateNode(mid);
+    joined = mid;
+  }
+  joined->parent = nullptr;
+  return joined;
+}
+
+/*Description: Function walks down the right spine of the taller tree l to
+  the first subtree short enough to pair with r under mid, then
+  rebalances on the way back up.
+  Parameters: std::shared_ptr<AVLNode> l, std::shared_ptr<AVLNode> mid,
+  std::shared_ptr<AVLNode> r
+  Returns: std::shared_ptr<AVLNode>
+*/
+std::shared_ptr<AVLNode> AVLTree::joinRight(std::shared_ptr<AVLNode> l, std::shared_ptr<AVLNode> mid, std::shared_ptr<AVLNode> r){
+  if (getHeight(l->right) <= getHeight(r) + 1) {
+    mid->left = l->right;
+    mid->right = r;
+    updateNode(mid);
+    l->right = mid;
+  } else {
+    l->right = joinRight(l->right, mid, r);
+  }
+  updateNode(l);
+  return rebalance(l);
+}
+
+/*Description: Mirror of joinRight for when r is the taller tree.
+  Parameters: std::shared_ptr<AVLNode> l, std::shared_ptr<AVLNode> mid,
+  std::shared_ptr<AVLNode> r
+  Returns: std::shared_ptr<AVLNode>
+*/
+std::shared_ptr<AVLNode> AVLTree::joinLeft(std::shared_ptr<AVLNode> l, std::shared_ptr<AVLNode> mid, std::shared_ptr<AVLNode> r){
+  if (getHeight(r->left) <= getHeight(l) + 1) {
+    mid->left = l;
+    mid->right = r->left;
+    updateNode(mid);
+    r->left = mid;
+  } else {
+    r->left = joinLeft(l, mid, r->left);
+  }
+  updateNode(r);
+  return rebalance(r);
+}
+
+/*Description: Function joins l and r where every value of l is less than
+  every value of r, using the maximum of l as the middle node.
+  Parameters: std::shared_ptr<AVLNode> l, std::shared_ptr<AVLNode> r
+  Returns: std::shared_ptr<AVLNode>
+*/
+std::shared_ptr<AVLNode> AVLTree::joinNodes(std::shared_ptr<AVLNode> l, std::shared_ptr<AVLNode> r){
+  if (l == nullptr) {
+    return r;
+  }
+  if (r == nullptr) {
+    l->parent = nullptr;
+    return l;
+  }
+  std::shared_ptr<AVLNode> last;
+  std::shared_ptr<AVLNode> rest = splitLast(l, last);
+  return joinNodes(rest, last, r);
+}
+
+/*Description: Function splits subtree n around k. Values less than k end
+  up in l and values greater than k in r. found reports whether k was in
+  n; its node is dropped.
+  Parameters: std::shared_ptr<AVLNode> n, int k,
+  std::shared_ptr<AVLNode> &l, bool &found, std::shared_ptr<AVLNode> &r
+  Returns: void
+*/
+void AVLTree::splitNode(std::shared_ptr<AVLNode> n, int k, std::shared_ptr<AVLNode> &l, bool &found, std::shared_ptr<AVLNode> &r){
+  if (n == nullptr) {
+    l = nullptr;
+    r = nullptr;
+    found = false;
+    return;
+  }
+
+  std::shared_ptr<AVLNode> left = n->left, right = n->right;
+  n->left = nullptr;
+  n->right = nullptr;
+
+  if (k < n->value) {
+    std::shared_ptr<AVLNode> between;
+    splitNode(left, k, l, found, between);
+    r = joinNodes(between, n, right);
+  } else if (k > n->value) {
+    std::shared_ptr<AVLNode> between;
+    splitNode(right, k, between, found, r);
+    l = joinNodes(left, n, between);
+  } else {
+    l = left;
+    r = right;
+    found = true;
+    if (l != nullptr) {
+      l->parent = nullptr;
+    }
+    if (r != nullptr) {
+      r->parent = nullptr;
+    }
+  }
+}
+
+/*Description: Function detaches the node holding the maximum of n into
+  last and returns the root of the remaining tree.
+  Parameters: std::shared_ptr<AVLNode> n, std::shared_ptr<AVLNode> &last
+  Returns: std::shared_ptr<AVLNode>
+*/
+std::shared_ptr<AVLNode> AVLTree::splitLast(std::shared_ptr<AVLNode> n, std::shared_ptr<AVLNode> &last){
+  if (n->right == nullptr) {
+    std::shared_ptr<AVLNode> rest = n->left;
+    n->left = nullptr;
+    last = n;
+    if (rest != nullptr) {
+      rest->parent = nullptr;
+    }
+    return rest;
+  }
+
+  std::shared_ptr<AVLNode> rest = splitLast(n->right, last);
+  std::shared_ptr<AVLNode> left = n->left;
+  n->left = nullptr;
+  n->right = nullptr;
+  return joinNodes(left, n, rest);
+}
+
+/*Description: Function returns root of the union of subtrees a and b.
+  b is split by the value at the root of a and the matching halves are
+  merged recursively. Nodes of a are kept, duplicates in b are dropped.
+  Parameters: std::shared_ptr<AVLNode> a, std::shared_ptr<AVLNode> b,
+  unsigned threads
+  Returns: std::shared_ptr<AVLNode>
+*/
+std::shared_ptr<AVLNode> AVLTree::unionNodes(std::shared_ptr<AVLNode> a, std::shared_ptr<AVLNode> b, unsigned threads){
+  if (a == nullptr) {
+    if (b != nullptr) {
+      b->parent = nullptr;
+    }
+    return b;
+  }
+  if (b == nullptr) {
+    a->parent = nullptr;
+    return a;
+  }
+
+  std::shared_ptr<AVLNode> aLeft = a->left, aRight = a->right;
+  a->left = nullptr;
+  a->right = nullptr;
+
+  std::shared_ptr<AVLNode> bLeft, bRight;
+  bool found;
+  splitNode(b, a->value, bLeft, found, bRight);
+  std::shared_ptr<AVLNode> left, right;
+  forkJoin([&](unsigned budget){ left = unionNodes(aLeft, bLeft, budget); },
+           [&](unsigned budget){ right = unionNodes(aRight, bRight, budget); },
+           threads, min(getSubtreeSize(aLeft), getSubtreeSize(bLeft)),
+           min(getSubtreeSize(aRight), getSubtreeSize(bRight)));
+  return joinNodes(left, a, right);
+}
+
+/*Description: Function returns root of the intersection of subtrees a
+  and b. Nodes of a are kept, nodes of b are dropped.
+  Parameters: std::shared_ptr<AVLNode> a, std::shared_ptr<AVLNode> b,
+  unsigned threads
+  Returns: std::shared_ptr<AVLNode>
+*/
+std::shared_ptr<AVLNode> AVLTree::intersectNodes(std::shared_ptr<AVLNode> a, std::shared_ptr<AVLNode> b, unsigned threads){
+  if (a == nullptr || b == nullptr) {
+    return nullptr;
+  }
+
+  std::shared_ptr<AVLNode> aLeft = a->left, aRight = a->right;
+  a->left = nullptr;
+  a->right = nullptr;
+
+  std::shared_ptr<AVLNode> bLeft, bRight;
+  bool found;
+  splitNode(b, a->value, bLeft, found, bRight);
+  std::shared_ptr<AVLNode> left, right;
+  forkJoin([&](unsigned budget){ left = intersectNodes(aLeft, bLeft, budget); },
+           [&](unsigned budget){ right = intersectNodes(aRight, bRight, budget); },
+           threads, min(getSubtreeSize(aLeft), getSubtreeSize(bLeft)),
+           min(getSubtreeSize(aRight), getSubtreeSize(bRight)));
+  if (found) {
+    return joinNodes(left, a, right);
+  }
+  return joinNodes(left, right);
+}
+
+/*Description: Function returns root of subtree a with every value of
+  subtree b removed.
+  Parameters: std::shared_ptr<AVLNode> a, std::shared_ptr<AVLNode> b,
+  unsigned threads
+  Returns: std::shared_ptr<AVLNode>
+*/
+std::shared_ptr<AVLNode> AVLTree::differenceNodes(std::shared_ptr<AVLNode> a, std::shared_ptr<AVLNode> b, unsigned threads){
+  if (a == nullptr) {
+    return nullptr;
+  }
+  if (b == nullptr) {
+    a->parent = nullptr;
+    return a;
+  }
+
+  std::shared_ptr<AVLNode> aLeft, aRight;
+  bool found;
+  splitNode(a, b->value, aLeft, found, aRight);
+  std::shared_ptr<AVLNode> bLeft = b->left, bRight = b->right;
+  std::shared_ptr<AVLNode> left, right;
+  forkJoin([&](unsigned budget){ left = differenceNodes(aLeft, bLeft, budget); },
+           [&](unsigned budget){ right = differenceNodes(aRight, bRight, budget); },
+           threads, min(getSubtreeSize(aLeft), getSubtreeSize(bLeft)),
+           min(getSubtreeSize(aRight), getSubtreeSize(bRight)));
+  return joinNodes(left, right);
+}
+
+/*Description: Function applies updates[lo, hi) to subtree n and returns
+  its new root. The updates are split around the value at n, each part is
+  applied to its side and n is joined back between the results, or the
+  two sides are joined without it if its count dropped to zero. An empty
+  subtree uses the middle update's value as the split point, so inserts
+  into it come out balanced.
+  Parameters: std::shared_ptr<AVLNode> n,
+  const std::vector<AVLTreeUpdate> &updates, int lo, int hi,
+  unsigned threads
+  Returns: std::shared_ptr<AVLNode>
+*/
+std::shared_ptr<AVLNode> AVLTree::applyNodes(std::shared_ptr<AVLNode> n, const std::vector<AVLTreeUpdate> &updates, int lo, int hi, unsigned threads){
+  if (lo == hi) {
+    if (n != nullptr) {
+      n->parent = nullptr;
+    }
+    return n;
+  }
+
+  auto byValue = [](const AVLTreeUpdate &a, const AVLTreeUpdate &b){ return a.value < b.value; };
+  AVLTreeUpdate pivot = {(n != nullptr) ? n->value : updates[lo + (hi - lo) / 2].value, false};
+  int first = lower_bound(updates.begin() + lo, updates.begin() + hi, pivot, byValue) - updates.begin();
+  int last = upper_bound(updates.begin() + first, updates.begin() + hi, pivot, byValue) - updates.begin();
+
+  std::shared_ptr<AVLNode> left, right;
+  if (n != nullptr) {
+    left = n->left;
+    right = n->right;
+    n->left = nullptr;
+    n->right = nullptr;
+  }
+  forkJoin([&](unsigned budget){ left = applyNodes(left, updates, lo, first, budget); },
+           [&](unsigned budget){ right = applyNodes(right, updates, last, hi, budget); },
+           threads, first - lo, hi - last);
+
+  int count = (n != nullptr) ? n->count : 0;
+  for (int i = first; i < last; i++) {
+    if (!updates[i].insert) {
+      count = max(count - 1, 0);
+    } else if (multiset || count == 0) {
+      count = count + 1;
+    }
+  }
+  if (count == 0) {
+    return joinNodes(left, right);
+  }
+  if (n == nullptr) {
+    AVL_STAT(allocations);
+    n = std::make_shared<AVLNode>(pivot.value);
+  }
+  n->count = count;
+  return joinNodes(left, n, right);
+}
\ No newline at end of file
@@ -6,23 +6,91 @@
 #define AVLTREE_H
 
 #include <memory>
+#include <string>
+#include <thread>
 #include <vector>
 #include "AVLNode.h"
+#include "AVLNodeArena.h"
+#include "AVLTreeIterator.h"
+#include "FrozenAVLTree.h"
+
+// Counters are only updated when built with -DTREE_STATS and stay zero
+// otherwise. The shape fields are filled in by treeStats() in any build.
+struct AVLTreeStats{
+  long long searches;
+  long long comparisons;
+  long long nodesVisited;
+  long long rotationsLeft;
+  long long rotationsRight;
+  long long rotationsLeftRight;
+  long long rotationsRightLeft;
+  long long allocations;
+  int height;
+  int maxLeafDepth;
+  double averageLeafDepth;
+  long long bytes;
+};
+
+// One update of a batch passed to applyBatch. A delete removes one copy of
+// value, so in multiset mode it only lowers the count.
+struct AVLTreeUpdate{
+  int value;
+  bool insert;
+};
 
 class AVLTree{
   public:
     AVLTree();
 
+    static AVLTree buildFromSorted(const std::vector<int>&);
+    static AVLTree fromUnsorted(std::vector<int>);
+
+    static AVLTree join(AVLTree&, int, AVLTree&);
+    static bool split(AVLTree&, int, AVLTree&, AVLTree&);
+    void unionWith(AVLTree&);
+    void intersect(AVLTree&);
+    void difference(AVLTree&);
+
+    FrozenAVLTree freeze();
+
+    bool save(const std::string&);
+    static bool load(const std::string&, AVLTree&);
+
+    void setParallelism(unsigned);
+    void insertBatch(const std::vector<int>&);
+    void deleteBatch(const std::vector<int>&);
+    void applyBatch(const std::vector<AVLTreeUpdate>&);
+    int eraseRange(int, int);
+    int eraseBelow(int);
+
     std::shared_ptr<AVLNode> getRoot();
     int getSize();
 
+    void setMultiset(bool);
+    int count(int);
+
     std::shared_ptr<AVLNode> search(int);
+    void searchBatch(const std::vector<int>&, std::vector<std::shared_ptr<AVLNode>>&, int);
+    std::shared_ptr<AVLNode> fingerSearch(int);
 
     std::shared_ptr<AVLNode> minimum();
     std::shared_ptr<AVLNode> maximum();
 
+    std::shared_ptr<AVLNode> select(int);
+    int rank(int);
+    int countInRange(int, int);
+
+    AVLTreeIterator begin();
+    AVLTreeIterator end();
+    AVLTreeIterator lowerBound(int);
+    AVLTreeIterator upperBound(int);
+
     void insertValue(int);
+    void fingerInsert(int);
     void deleteValue(int);
+
+    AVLTreeStats treeStats();
+    void resetStats();
   
     void preOrder(std::shared_ptr<AVLNode>, std::vector<std::shared_ptr<AVLNode>>&);
     void inOrder(std::shared_ptr<AVLNode>, std::vector<std::shared_ptr<AVLNode>>&);
@@ -31,12 +99,73 @@ class AVLTree{
   private:
     std::shared_ptr<AVLNode> root;
     int size;
+    unsigned parallelism;
+    bool multiset;
+    AVLTreeStats counters;
+    AVLNode* finger; // last node found or inserted by the finger operations,
+                     // reset by any update that may free or move nodes
+
+    static const int parallelGrainSize = 1 << 14;
+    static const int maxSearchGroup = 32;
 
-    std::shared_ptr<AVLNode> search(std::shared_ptr<AVLNode>, int);
     std::shared_ptr<AVLNode> minimum(std::shared_ptr<AVLNode>);
     std::shared_ptr<AVLNode> maximum(std::shared_ptr<AVLNode>);
     std::shared_ptr<AVLNode> insertValue(std::shared_ptr<AVLNode>, int);
     std::shared_ptr<AVLNode> deleteValue(std::shared_ptr<AVLNode>, int);
+    AVLNode* climbFromFinger(int);
+    std::shared_ptr<AVLNode>& slotOf(AVLNode*);
+
+    static int getHeight(const std::shared_ptr<AVLNode>&);
+    static int getBalanceFactor(const std::shared_ptr<AVLNode>&);
+    static int getSubtreeSize(const std::shared_ptr<AVLNode>&);
+    static void updateSubtreeSize(const std::shared_ptr<AVLNode>&);
+    int countBelow(int, bool);
+
+    static std::shared_ptr<AVLNode> buildFromSorted(const std::vector<int>&, int, int);
+    static std::shared_ptr<AVLNode> linkFromSorted(AVLNodeAllocator<AVLNode>&,
+        const std::vector<int>&, int, int);
+    static void parallelSort(std::vector<int>&, size_t, size_t, unsigned);
+
+    /*Description: Function runs first(budget) and second(budget). When
+      the thread budget allows it and both sides hold at least
+      parallelGrainSize nodes, first runs on a new thread and the budget
+      is divided between the sides in proportion to their work. Otherwise
+      both run on the calling thread and each keeps the whole budget, so
+      a lopsided split loses no threads and the larger side can still
+      fork further down. The set operations cost O(m log(n / m + 1)) for
+      inputs of m <= n nodes and return at once when either is empty, so
+      callers pass the smaller input of each side as its work, and the
+      number of updates for applyBatch.
+      Parameters: const First &first, const Second &second,
+      unsigned threads, int firstWork, int secondWork
+      Returns: void
+    */
+    template <typename First, typename Second>
+    static void forkJoin(const First &first, const Second &second, unsigned threads, int firstWork, int secondWork){
+      if (threads < 2 || firstWork < parallelGrainSize || secondWork < parallelGrainSize) {
+        first(threads);
+        second(threads);
+        return;
+      }
+
+      long long share = (long long)threads * firstWork / ((long long)firstWork + secondWork);
+      unsigned firstThreads = (share < 1) ? 1 : (share >= threads) ? threads - 1 : (unsigned)share;
+      std::thread firstThread([&first, firstThreads]{ first(firstThreads); });
+      second(threads - firstThreads);
+      firstThread.join();
+    }
+
+    static void updateNode(const std::shared_ptr<AVLNode>&);
+    std::shared_ptr<AVLNode> joinNodes(std::shared_ptr<AVLNode>, std::shared_ptr<AVLNode>, std::shared_ptr<AVLNode>);
+    std::shared_ptr<AVLNode> joinRight(std::shared_ptr<AVLNode>, std::shared_ptr<AVLNode>, std::shared_ptr<AVLNode>);
+    std::shared_ptr<AVLNode> joinLeft(std::shared_ptr<AVLNode>, std::shared_ptr<AVLNode>, std::shared_ptr<AVLNode>);
+    std::shared_ptr<AVLNode> joinNodes(std::shared_ptr<AVLNode>, std::shared_ptr<AVLNode>);
+    void splitNode(std::shared_ptr<AVLNode>, int, std::shared_ptr<AVLNode>&, bool&, std::shared_ptr<AVLNode>&);
+    std::shared_ptr<AVLNode> splitLast(std::shared_ptr<AVLNode>, std::shared_ptr<AVLNode>&);
+    std::shared_ptr<AVLNode> unionNodes(std::shared_ptr<AVLNode>, std::shared_ptr<AVLNode>, unsigned);
+    std::shared_ptr<AVLNode> intersectNodes(std::shared_ptr<AVLNode>, std::shared_ptr<AVLNode>, unsigned);
+    std::shared_ptr<AVLNode> differenceNodes(std::shared_ptr<AVLNode>, std::shared_ptr<AVLNode>, unsigned);
+    std::shared_ptr<AVLNode> applyNodes(std::shared_ptr<AVLNode>, const std::vector<AVLTreeUpdate>&, int, int, unsigned);
 
     std::shared_ptr<AVLNode> rebalance(std::shared_ptr<AVLNode>);
     std::shared_ptr<AVLNode> rotateLeft(std::shared_ptr<AVLNode>);
@@ -0,0 +1,95 @@
+// File: AVLTreeBatchBenchmark.cpp
+// Description: Compares applying a sorted batch of mixed inserts and
+// deletes one update at a time with insertValue/deleteValue against one
+// applyBatch call, on one thread and on every hardware thread. Each run
+// starts from a tree of n random keys drawn from [0, 2n); batch updates
+// are 70% inserts and 30% deletes over the same range. Batches are sorted
+// before timing starts.
+// Prints one CSV line per method and batch size:
+//   method,threads,n,batch,seconds,updates_per_second
+// Usage: ./AVLTreeBatchBenchmark [n]
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <vector>
+#include "AVLTree.h"
+using namespace std;
+
+typedef chrono::steady_clock Clock;
+
+AVLTree buildBase(const vector<int> &sortedKeys, unsigned threads);
+void report(const char* method, unsigned threads, int n, int batch, double seconds);
+
+int main(int argc, char** argv){
+  int n = (argc > 1) ? atoi(argv[1]) : 1000000;
+  unsigned hardwareThreads = max(1u, thread::hardware_concurrency());
+
+  mt19937 gen(46);
+  vector<int> keys(n);
+  for (int i = 0; i < n; i++){
+    keys[i] = gen() % (2 * n);
+  }
+  sort(keys.begin(), keys.end());
+  keys.erase(unique(keys.begin(), keys.end()), keys.end());
+
+  long checksum = 0;
+  for (int batch = 1000; batch <= n; batch *= 10){
+    vector<AVLTreeUpdate> updates(batch);
+    for (int i = 0; i < batch; i++){
+      updates[i].value = gen() % (2 * n);
+      updates[i].insert = gen() % 10 < 7;
+    }
+    stable_sort(updates.begin(), updates.end(),
+                [](const AVLTreeUpdate &a, const AVLTreeUpdate &b){ return a.value < b.value; });
+
+    {
+      AVLTree tree = buildBase(keys, 1);
+      Clock::time_point start = Clock::now();
+      for (int i = 0; i < batch; i++){
+        if (updates[i].insert){ tree.insertValue(updates[i].value); }
+        else { tree.deleteValue(updates[i].value); }
+      }
+      report("per_update", 1, n, batch, chrono::duration<double>(Clock::now() - start).count());
+      checksum += tree.getSize();
+    }
+
+    for (unsigned threads : {1u, hardwareThreads}){
+      AVLTree tree = buildBase(keys, threads);
+      Clock::time_point start = Clock::now();
+      tree.applyBatch(updates);
+      report("applyBatch", threads, n, batch, chrono::duration<double>(Clock::now() - start).count());
+      checksum += tree.getSize();
+      if (hardwareThreads == 1){ break; }
+    }
+  }
+
+  cerr << "checksum " << checksum << endl;
+  return 0;
+}
+
+/****************************************************************
+ * Build a fresh tree holding the starting keys                 *
+ * sortedKeys - const vector<int> & - distinct keys, ascending  *
+ * threads - unsigned - parallelism for the tree                *
+ * *************************************************************/
+AVLTree buildBase(const vector<int> &sortedKeys, unsigned threads){
+  AVLTree tree = AVLTree::buildFromSorted(sortedKeys);
+  tree.setParallelism(threads);
+  return tree;
+}
+
+/****************************************************************
+ * Print one CSV result line                                    *
+ * method - const char* - how the batch was applied             *
+ * threads - unsigned - threads available to the method         *
+ * n - int - number of keys requested for the starting tree     *
+ * batch - int - number of updates timed                        *
+ * seconds - double - time taken by all updates                 *
+ * *************************************************************/
+void report(const char* method, unsigned threads, int n, int batch, double seconds){
+  cout << method << "," << threads << "," << n << "," << batch << "," << seconds << "," << (batch / seconds) << endl;
+}
@@ -0,0 +1,102 @@
+// File: AVLTreeBenchmark.cpp
+// Description: Compares insertValue/search, which start every operation at
+// the root, with fingerInsert/fingerSearch, which start at the previous
+// operation's node. Three key traces are used: monotone (0, 1, 2, ...),
+// nearly monotone (increasing keys each displaced by up to jitter places)
+// and uniformly random as a control. Each trace is inserted into an empty
+// tree and then looked up in the same order. Finger lookups depend on the
+// previous result, so unlike root searches consecutive lookups cannot
+// overlap their cache misses; they pay off only when keys are close.
+// Prints one CSV line per structure, trace and operation:
+//   structure,trace,operation,n,seconds,ops_per_second
+// Usage: ./AVLTreeBenchmark [n] [jitter]
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+#include "AVLTree.h"
+using namespace std;
+
+typedef chrono::steady_clock Clock;
+
+void runTrace(const char* trace, const vector<int> &keys, long &checksum);
+void report(const char* structure, const char* trace, const char* operation, int n, double seconds);
+
+int main(int argc, char** argv){
+  int n = (argc > 1) ? atoi(argv[1]) : 1000000;
+  int jitter = (argc > 2) ? atoi(argv[2]) : 16;
+
+  mt19937 gen(44);
+  vector<int> monotone(n);
+  for (int i = 0; i < n; i++){
+    monotone[i] = i;
+  }
+
+  // Shuffle each window of jitter keys so every key lands at most jitter
+  // places from its sorted position.
+  vector<int> nearlyMonotone = monotone;
+  for (int i = 0; i < n; i += jitter){
+    shuffle(nearlyMonotone.begin() + i, nearlyMonotone.begin() + min(n, i + jitter), gen);
+  }
+
+  vector<int> random = monotone;
+  shuffle(random.begin(), random.end(), gen);
+
+  long checksum = 0;
+  runTrace("monotone", monotone, checksum);
+  runTrace("nearly_monotone", nearlyMonotone, checksum);
+  runTrace("random", random, checksum);
+
+  cerr << "checksum " << checksum << endl;
+  return 0;
+}
+
+/****************************************************************
+ * Time inserting then looking up keys in order, once from the  *
+ * root and once from the finger                                *
+ * trace - const char* - name of the key trace                  *
+ * keys - const vector<int> & - keys in arrival order           *
+ * checksum - long & - accumulates results so work is not       *
+ *   optimized away                                             *
+ * *************************************************************/
+void runTrace(const char* trace, const vector<int> &keys, long &checksum){
+  int n = keys.size();
+  Clock::time_point start;
+
+  {
+    AVLTree tree;
+    start = Clock::now();
+    for (int i = 0; i < n; i++){ tree.insertValue(keys[i]); }
+    report("AVLTree", trace, "insert", n, chrono::duration<double>(Clock::now() - start).count());
+
+    start = Clock::now();
+    for (int i = 0; i < n; i++){ checksum += (tree.search(keys[i]) != nullptr); }
+    report("AVLTree", trace, "search", n, chrono::duration<double>(Clock::now() - start).count());
+  }
+
+  {
+    AVLTree tree;
+    start = Clock::now();
+    for (int i = 0; i < n; i++){ tree.fingerInsert(keys[i]); }
+    report("AVLTreeFinger", trace, "insert", n, chrono::duration<double>(Clock::now() - start).count());
+
+    start = Clock::now();
+    for (int i = 0; i < n; i++){ checksum += (tree.fingerSearch(keys[i]) != nullptr); }
+    report("AVLTreeFinger", trace, "search", n, chrono::duration<double>(Clock::now() - start).count());
+  }
+}
+
+/****************************************************************
+ * Print one CSV result line                                    *
+ * structure - const char* - name of the variant measured       *
+ * trace - const char* - name of the key trace                  *
+ * operation - const char* - name of the operation timed        *
+ * n - int - number of operations timed                         *
+ * seconds - double - time taken by all operations              *
+ * *************************************************************/
+void report(const char* structure, const char* trace, const char* operation, int n, double seconds){
+  cout << structure << "," << trace << "," << operation << "," << n << "," << seconds << "," << (n / seconds) << endl;
+}
@@ -11,6 +11,11 @@ void printVector(const vector<std::shared_ptr<AVLNode>> &v);
 void runSearch(std::shared_ptr<AVLTree> T);
 void runInsert(std::shared_ptr<AVLTree> T);
 void runDelete(std::shared_ptr<AVLTree> T);
+void runSelect(std::shared_ptr<AVLTree> T);
+void runRank(std::shared_ptr<AVLTree> T);
+void runCountInRange(std::shared_ptr<AVLTree> T);
+void runRange(std::shared_ptr<AVLTree> T);
+void printStats(const AVLTreeStats &stats);
 
 /****************************************
  * Simple main to test AVL Tree methods *
@@ -68,6 +73,26 @@ int main(){
         cout << "SIZE" << endl;
         cout << T->getSize() << endl;
         break;
+      case 10: // select
+        cout << "SELECT ";
+        runSelect(T);
+        break;
+      case 11: // rank
+        cout << "RANK ";
+        runRank(T);
+        break;
+      case 12: // count in range
+        cout << "COUNT IN RANGE ";
+        runCountInRange(T);
+        break;
+      case 13: // range scan
+        cout << "RANGE ";
+        runRange(T);
+        break;
+      case 14: // tree statistics
+        cout << "STATS" << endl;
+        printStats(T->treeStats());
+        break;
       default:
         break;
     }
@@ -121,4 +146,74 @@ void runDelete(std::shared_ptr<AVLTree> T){
   cin >> remove;
   cout << remove << endl;
   T->deleteValue(remove);
+}
+
+/****************************************************************************************
+ * Given an AVL Tree, get an index k from the console and print the k-th smallest value *
+ * T - std::shared_ptr<AVLTree> - an AVL Tree                                           *
+ * *************************************************************************************/
+void runSelect(std::shared_ptr<AVLTree> T){
+  int k;
+  cin >> k;
+  cout << k << endl;
+  std::shared_ptr<AVLNode> n = T->select(k);
+  if (n){ cout << n->value << endl; }
+  else{ cout << "null" << endl; }
+}
+
+/*****************************************************************************************
+ * Given an AVL Tree, get a value from the console and print how many values are smaller *
+ * T - std::shared_ptr<AVLTree> - an AVL Tree                                            *
+ * **************************************************************************************/
+void runRank(std::shared_ptr<AVLTree> T){
+  int val;
+  cin >> val;
+  cout << val << endl;
+  cout << T->rank(val) << endl;
+}
+
+/******************************************************************************************************
+ * Given an AVL Tree, get bounds lo and hi from the console and print how many values lie in [lo, hi] *
+ * T - std::shared_ptr<AVLTree> - an AVL Tree                                                         *
+ * ***************************************************************************************************/
+void runCountInRange(std::shared_ptr<AVLTree> T){
+  int lo, hi;
+  cin >> lo >> hi;
+  cout << lo << " " << hi << endl;
+  cout << T->countInRange(lo, hi) << endl;
+}
+
+/*********************************************************************************************
+ * Given an AVL Tree, get bounds lo and hi from the console and print the values in [lo, hi] *
+ * T - std::shared_ptr<AVLTree> - an AVL Tree                                                *
+ * ******************************************************************************************/
+void runRange(std::shared_ptr<AVLTree> T){
+  int lo, hi;
+  cin >> lo >> hi;
+  cout << lo << " " << hi << endl;
+  AVLTreeIterator last = T->upperBound(hi);
+  for (AVLTreeIterator it = T->lowerBound(lo); it != last; ++it){
+    cout << it->value << " ";
+  }
+  cout << endl;
+}
+
+/*************************************************************************
+ * Print counters and shape of a tree, one "name value" pair per line.   *
+ * Counters are zero unless the driver was built with -DTREE_STATS       *
+ * stats - const AVLTreeStats & - result of AVLTree::treeStats           *
+ * ***********************************************************************/
+void printStats(const AVLTreeStats &stats){
+  cout << "searches " << stats.searches << endl;
+  cout << "comparisons " << stats.comparisons << endl;
+  cout << "nodesVisited " << stats.nodesVisited << endl;
+  cout << "rotationsLeft " << stats.rotationsLeft << endl;
+  cout << "rotationsRight " << stats.rotationsRight << endl;
+  cout << "rotationsLeftRight " << stats.rotationsLeftRight << endl;
+  cout << "rotationsRightLeft " << stats.rotationsRightLeft << endl;
+  cout << "allocations " << stats.allocations << endl;
+  cout << "height " << stats.height << endl;
+  cout << "maxLeafDepth " << stats.maxLeafDepth << endl;
+  cout << "averageLeafDepth " << stats.averageLeafDepth << endl;
+  cout << "bytes " << stats.bytes << endl;
 }
\ No newline at end of file
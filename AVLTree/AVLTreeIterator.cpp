@@ -0,0 +1,102 @@
+// File: AVLTreeIterator.cpp
+// Description: File contains in order stepping for AVLTreeIterator using
+// the parent links kept by AVLTree.
+
+#include "AVLTreeIterator.h"
+#include "AVLTree.h"
+
+// Default constructor, yields an iterator not attached to any tree
+AVLTreeIterator::AVLTreeIterator(){
+  node = nullptr;
+  tree = nullptr;
+}
+
+/*Description: Constructor for iterator positioned at n in tree t. Passing
+  nullptr for n gives the end iterator of t.
+  Parameters: AVLNode* n, AVLTree* t
+  Returns: N/A
+*/
+AVLTreeIterator::AVLTreeIterator(AVLNode* n, AVLTree* t){
+  node = n;
+  tree = t;
+}
+
+AVLNode& AVLTreeIterator::operator*() const{
+  return *node;
+}
+
+AVLNode* AVLTreeIterator::operator->() const{
+  return node;
+}
+
+/*Description: Function advances iterator to the in order successor. The
+  successor is the leftmost node of the right subtree if there is one,
+  else the first ancestor reached from a left child.
+  Parameters: N/A
+  Returns: AVLTreeIterator&
+*/
+AVLTreeIterator& AVLTreeIterator::operator++(){
+  if (node->right != nullptr) {
+    node = node->right.get();
+    while (node->left != nullptr) {
+      node = node->left.get();
+    }
+    return *this;
+  }
+
+  AVLNode* parent = node->parent;
+  while (parent != nullptr && parent->right.get() == node) {
+    node = parent;
+    parent = parent->parent;
+  }
+  node = parent;
+  return *this;
+}
+
+AVLTreeIterator AVLTreeIterator::operator++(int){
+  AVLTreeIterator old = *this;
+  ++(*this);
+  return old;
+}
+
+/*Description: Function moves iterator to the in order predecessor.
+  Decrementing the end iterator yields the maximum of the tree.
+  Parameters: N/A
+  Returns: AVLTreeIterator&
+*/
+AVLTreeIterator& AVLTreeIterator::operator--(){
+  if (node == nullptr) {
+    node = tree->maximum().get();
+    return *this;
+  }
+
+  if (node->left != nullptr) {
+    node = node->left.get();
+    while (node->right != nullptr) {
+      node = node->right.get();
+    }
+    return *this;
+  }
+
+  AVLNode* parent = node->parent;
+  while (parent != nullptr && parent->left.get() == node) {
+    node = parent;
+    parent = parent->parent;
+  }
+  node = parent;
+  return *this;
+}
+
+AVLTreeIterator AVLTreeIterator::operator--(int){
+  AVLTreeIterator old = *this;
+  --(*this);
+  return old;
+}
+
+bool AVLTreeIterator::operator==(const AVLTreeIterator& other) const{
+  return node == other.node;
+}
+
+bool AVLTreeIterator::operator!=(const AVLTreeIterator& other) const{
+  return node != other.node;
+}
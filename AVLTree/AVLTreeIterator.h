@@ -0,0 +1,43 @@
+// File: AVLTreeIterator.h
+// Description: Bidirectional iterator that walks the nodes of an AVLTree in
+// ascending order. Steps follow the parent links of AVLNode, so iterating
+// allocates nothing and a scan of k nodes after a lowerBound costs
+// O(log n + k).
+
+#ifndef AVLTREEITERATOR_H
+#define AVLTREEITERATOR_H
+
+#include <cstddef>
+#include <iterator>
+#include "AVLNode.h"
+
+class AVLTree;
+
+class AVLTreeIterator{
+  public:
+    typedef std::bidirectional_iterator_tag iterator_category;
+    typedef AVLNode value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef AVLNode* pointer;
+    typedef AVLNode& reference;
+
+    AVLTreeIterator();
+    AVLTreeIterator(AVLNode*, AVLTree*);
+
+    AVLNode& operator*() const;
+    AVLNode* operator->() const;
+
+    AVLTreeIterator& operator++();
+    AVLTreeIterator operator++(int);
+    AVLTreeIterator& operator--();
+    AVLTreeIterator operator--(int);
+
+    bool operator==(const AVLTreeIterator&) const;
+    bool operator!=(const AVLTreeIterator&) const;
+
+  private:
+    AVLNode* node; // nullptr marks the past-the-end position
+    AVLTree* tree;
+};
+
+#endif
@@ -0,0 +1,94 @@
+// File: AVLTreeParallelBenchmark.cpp
+// Description: Measures how unionWith, intersect and difference scale with
+// setParallelism, for 1, 2, 4, ... up to maxThreads threads. Two input
+// shapes are used:
+//   balanced  both trees hold n random keys from [0, 4n)
+//   skewed    the second tree holds n / 2 keys packed into the top 10% of
+//             the key range, so the splits near the root are lopsided
+// Trees are built before timing starts. Speedup is against the 1 thread
+// run of the same operation and shape. Prints one CSV line per operation,
+// shape and thread count:
+//   operation,shape,threads,n,seconds,speedup
+// Usage: ./AVLTreeParallelBenchmark [n] [maxThreads]
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <vector>
+#include "AVLTree.h"
+using namespace std;
+
+typedef chrono::steady_clock Clock;
+
+double timeOperation(int operation, const vector<int> &first, const vector<int> &second, unsigned threads, long &checksum);
+
+int main(int argc, char** argv){
+  int n = (argc > 1) ? atoi(argv[1]) : 2000000;
+  unsigned maxThreads = (argc > 2) ? atoi(argv[2]) : thread::hardware_concurrency();
+  if (maxThreads < 1){
+    maxThreads = 1;
+  }
+  const char* operations[] = {"union", "intersect", "difference"};
+  const char* shapes[] = {"balanced", "skewed"};
+
+  mt19937 gen(31);
+  vector<int> first(n), balanced(n), skewed(n / 2);
+  for (int i = 0; i < n; i++){
+    first[i] = gen() % (4 * n);
+    balanced[i] = gen() % (4 * n);
+  }
+  for (size_t i = 0; i < skewed.size(); i++){
+    skewed[i] = 4 * n - 1 - (int)(gen() % (2 * n / 5 + 1));
+  }
+
+  // shared_ptr counts skip atomic instructions until the process starts
+  // its first thread, which would flatter whichever run came first
+  thread([]{}).join();
+
+  long checksum = 0;
+  for (int s = 0; s < 2; s++){
+    const vector<int> &second = (s == 0) ? balanced : skewed;
+    for (int op = 0; op < 3; op++){
+      double baseline = 0;
+      for (unsigned threads = 1; threads <= maxThreads; threads *= 2){
+        double seconds = timeOperation(op, first, second, threads, checksum);
+        if (threads == 1){
+          baseline = seconds;
+        }
+        cout << operations[op] << "," << shapes[s] << "," << threads << "," << n << ","
+             << seconds << "," << (baseline / seconds) << endl;
+      }
+    }
+  }
+
+  cerr << "checksum " << checksum << endl;
+  return 0;
+}
+
+/****************************************************************
+ * Build both trees, then time one bulk operation on them       *
+ * operation - int - 0 union, 1 intersect, 2 difference         *
+ * first - const vector<int> & - keys of the tree updated       *
+ * second - const vector<int> & - keys of the other tree        *
+ * threads - unsigned - parallelism for the operation           *
+ * checksum - long & - size of the result is added to it        *
+ * *************************************************************/
+double timeOperation(int operation, const vector<int> &first, const vector<int> &second, unsigned threads, long &checksum){
+  AVLTree a = AVLTree::fromUnsorted(first);
+  AVLTree b = AVLTree::fromUnsorted(second);
+  a.setParallelism(threads);
+
+  Clock::time_point start = Clock::now();
+  if (operation == 0){
+    a.unionWith(b);
+  } else if (operation == 1){
+    a.intersect(b);
+  } else {
+    a.difference(b);
+  }
+  double seconds = chrono::duration<double>(Clock::now() - start).count();
+  checksum += a.getSize();
+  return seconds;
+}
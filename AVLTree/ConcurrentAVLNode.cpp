@@ -0,0 +1,21 @@
+// File: ConcurrentAVLNode.cpp
+// Description: File contains constructor for ConcurrentAVLNode.
+
+#include "ConcurrentAVLNode.h"
+
+const long long ConcurrentAVLNode::SHRINKING;
+const long long ConcurrentAVLNode::UNLINKED;
+const long long ConcurrentAVLNode::VERSION_STEP;
+
+/*Description: Constructor for a present leaf holding k below parent p.
+  Parameters: int k, ConcurrentAVLNode* p
+  Returns: N/A
+*/
+ConcurrentAVLNode::ConcurrentAVLNode(int k, ConcurrentAVLNode* p) : key(k){
+  present = true;
+  height = 1;
+  version = 0;
+  left = nullptr;
+  right = nullptr;
+  parent = p;
+}
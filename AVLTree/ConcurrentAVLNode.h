@@ -0,0 +1,32 @@
+// File: ConcurrentAVLNode.h
+// Description: Node of a ConcurrentAVLTree. Links, height and presence are
+// atomics so readers can traverse without locks. version is bumped by
+// every rotation that shrinks the key range below the node, which lets a
+// reader detect that the subtree it is in was changed under it.
+
+#ifndef CONCURRENTAVLNODE_H
+#define CONCURRENTAVLNODE_H
+
+#include <atomic>
+#include <mutex>
+
+class ConcurrentAVLNode{
+  public:
+    // bits of version
+    static const long long SHRINKING = 1;   // a rotation is moving keys out of this subtree
+    static const long long UNLINKED = 2;    // node has been removed from the tree
+    static const long long VERSION_STEP = 4;
+
+    const int key;
+    std::atomic<bool> present; // false for a deleted key still used for routing
+    std::atomic<int> height;   // 1 for a leaf, 0 for an empty subtree
+    std::atomic<long long> version;
+    std::atomic<ConcurrentAVLNode*> left;
+    std::atomic<ConcurrentAVLNode*> right;
+    std::atomic<ConcurrentAVLNode*> parent;
+    std::mutex lock;
+
+    ConcurrentAVLNode(int, ConcurrentAVLNode*);
+};
+
+#endif
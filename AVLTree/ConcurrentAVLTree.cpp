@@ -0,0 +1,539 @@
+// File: ConcurrentAVLTree.cpp
+// Description: File contains the optimistic lookups, the locking updates
+// and the relaxed rebalancing of ConcurrentAVLTree.
+
+#include <algorithm>
+#include <functional>
+#include <thread>
+#include "ConcurrentAVLTree.h"
+
+// Constructor for ConcurrentAVLTree class
+ConcurrentAVLTree::ConcurrentAVLTree(){
+  rootHolder = new ConcurrentAVLNode(0, nullptr);
+  rootHolder->present = false;
+  size = 0;
+  globalEpoch = 1;
+  for (int i = 0; i < epochSlots; i++) {
+    slots[i].epoch = 0;
+  }
+  retiredCount = 0;
+}
+
+// Destructor for ConcurrentAVLTree class, must not run concurrently with
+// any other operation
+ConcurrentAVLTree::~ConcurrentAVLTree(){
+  destroy(rootHolder);
+  for (size_t i = 0; i < retired.size(); i++) {
+    delete retired[i].node;
+  }
+}
+
+/*Description: Function returns number of values in ConcurrentAVLTree.
+  Parameters: N/A
+  Returns: int
+*/
+int ConcurrentAVLTree::getSize(){
+  return size.load();
+}
+
+/*Description: Function returns true if val is in ConcurrentAVLTree.
+  Never blocks on writers except to wait out a rotation in progress.
+  Parameters: int val
+  Returns: bool
+*/
+bool ConcurrentAVLTree::search(int val){
+  int slot = enterEpoch();
+  Result result;
+  do {
+    result = attemptSearch(val);
+  } while (result == RETRY);
+  leaveEpoch(slot);
+  return result == FOUND;
+}
+
+/*Description: Function inserts val. Safe to call from many threads.
+  Parameters: int val
+  Returns: bool - true if val was not already present
+*/
+bool ConcurrentAVLTree::insertValue(int val){
+  int slot = enterEpoch();
+  Result result;
+  do {
+    result = attemptInsert(val);
+  } while (result == RETRY);
+  leaveEpoch(slot);
+  if (result == CHANGED) {
+    size++;
+  }
+  return result == CHANGED;
+}
+
+/*Description: Function deletes val. Safe to call from many threads.
+  Parameters: int val
+  Returns: bool - true if val was present
+*/
+bool ConcurrentAVLTree::deleteValue(int val){
+  int slot = enterEpoch();
+  Result result;
+  do {
+    result = attemptDelete(val);
+  } while (result == RETRY);
+  leaveEpoch(slot);
+  if (result == CHANGED) {
+    size--;
+  }
+  return result == CHANGED;
+}
+
+/*Description: Function appends present values in ascending order. The
+  result is only a consistent snapshot when no update runs concurrently.
+  Parameters: std::vector<int> &order
+  Returns: void
+*/
+void ConcurrentAVLTree::inOrder(std::vector<int> &order){
+  int slot = enterEpoch();
+  inOrder(rootHolder->right.load(), order);
+  leaveEpoch(slot);
+}
+
+ConcurrentAVLNode* ConcurrentAVLTree::child(ConcurrentAVLNode* n, bool goRight){
+  return goRight ? n->right.load() : n->left.load();
+}
+
+int ConcurrentAVLTree::getHeight(ConcurrentAVLNode* n){
+  return (n == nullptr) ? 0 : n->height.load();
+}
+
+void ConcurrentAVLTree::waitUntilNotShrinking(ConcurrentAVLNode* n){
+  while ((n->version.load() & ConcurrentAVLNode::SHRINKING) != 0) {
+    std::this_thread::yield();
+  }
+}
+
+/*Description: Function claims a free announcement slot and publishes the
+  current global epoch in it. Until the matching leaveEpoch no node this
+  thread can reach is deleted. A stale epoch is harmless, it only holds
+  reclamation back further.
+  Parameters: N/A
+  Returns: int - slot to hand to leaveEpoch
+*/
+int ConcurrentAVLTree::enterEpoch(){
+  static thread_local int hint = (int)(std::hash<std::thread::id>()(std::this_thread::get_id()) % epochSlots);
+  while (true) {
+    for (int i = 0; i < epochSlots; i++) {
+      int slot = (hint + i) % epochSlots;
+      unsigned long long expected = 0;
+      if (slots[slot].epoch.load() == 0 &&
+          slots[slot].epoch.compare_exchange_strong(expected, globalEpoch.load())) {
+        hint = slot;
+        return slot;
+      }
+    }
+    std::this_thread::yield();
+  }
+}
+
+/*Description: Function clears the announcement made by enterEpoch and,
+  once enough unlinked nodes are waiting, tries to free some of them.
+  Parameters: int slot
+  Returns: void
+*/
+void ConcurrentAVLTree::leaveEpoch(int slot){
+  slots[slot].epoch = 0;
+  if (retiredCount.load() >= reclaimThreshold) {
+    reclaim();
+  }
+}
+
+/*Description: Function queues an unlinked node, tagged with the epoch it
+  was unlinked in. Called with the parent and node locks held.
+  Parameters: ConcurrentAVLNode* n
+  Returns: void
+*/
+void ConcurrentAVLTree::retire(ConcurrentAVLNode* n){
+  std::lock_guard<std::mutex> guard(retiredLock);
+  RetiredNode entry = {globalEpoch.load(), n};
+  retired.push_back(entry);
+  retiredCount++;
+}
+
+/*Description: Function advances the global epoch past every operation
+  that has announced it, at most twice, then deletes the nodes retired two
+  or more epochs ago. Skips the work if another thread is already at it.
+  Parameters: N/A
+  Returns: void
+*/
+void ConcurrentAVLTree::reclaim(){
+  std::vector<ConcurrentAVLNode*> freeable;
+  {
+    std::unique_lock<std::mutex> guard(retiredLock, std::try_to_lock);
+    if (!guard.owns_lock()) {
+      return;
+    }
+    for (int step = 0; step < 2; step++) {
+      unsigned long long current = globalEpoch.load();
+      bool allCaughtUp = true;
+      for (int i = 0; i < epochSlots && allCaughtUp; i++) {
+        unsigned long long announced = slots[i].epoch.load();
+        allCaughtUp = (announced == 0 || announced == current);
+      }
+      if (!allCaughtUp) {
+        break;
+      }
+      globalEpoch = current + 1;
+    }
+
+    unsigned long long current = globalEpoch.load();
+    while (!retired.empty() && retired.front().epoch + 2 <= current) {
+      freeable.push_back(retired.front().node);
+      retired.pop_front();
+    }
+    retiredCount -= (int)freeable.size();
+  }
+  for (size_t i = 0; i < freeable.size(); i++) {
+    delete freeable[i];
+  }
+}
+
+/*Description: Function makes one optimistic descent for val. At each step
+  the child link is read and then the parent's version is checked again:
+  if it still matches, the child was reached while the parent's subtree
+  still covered val. Any mismatch means a concurrent rotation moved keys
+  and the descent restarts from the root.
+  Parameters: int val
+  Returns: Result - FOUND, NOT_FOUND or RETRY
+*/
+ConcurrentAVLTree::Result ConcurrentAVLTree::attemptSearch(int val){
+  ConcurrentAVLNode* n = rootHolder;
+  long long version = n->version.load();
+  bool goRight = true;
+
+  while (true) {
+    ConcurrentAVLNode* c = child(n, goRight);
+    if (n->version.load() != version) {
+      return RETRY;
+    }
+    if (c == nullptr) {
+      return NOT_FOUND;
+    }
+
+    if (c->key == val) {
+      bool present = c->present.load();
+      if ((c->version.load() & ConcurrentAVLNode::UNLINKED) != 0) {
+        return RETRY;
+      }
+      return present ? FOUND : NOT_FOUND;
+    }
+
+    long long childVersion = c->version.load();
+    if ((childVersion & (ConcurrentAVLNode::SHRINKING | ConcurrentAVLNode::UNLINKED)) != 0) {
+      waitUntilNotShrinking(c);
+      return RETRY;
+    }
+    if (child(n, goRight) != c || n->version.load() != version) {
+      return RETRY;
+    }
+
+    n = c;
+    version = childVersion;
+    goRight = val > c->key;
+  }
+}
+
+/*Description: Function descends like attemptSearch. An empty slot is
+  filled after locking its parent and checking the parent is unchanged;
+  a node holding val that was deleted is marked present again.
+  Parameters: int val
+  Returns: Result - CHANGED, UNCHANGED or RETRY
+*/
+ConcurrentAVLTree::Result ConcurrentAVLTree::attemptInsert(int val){
+  ConcurrentAVLNode* n = rootHolder;
+  long long version = n->version.load();
+  bool goRight = true;
+
+  while (true) {
+    ConcurrentAVLNode* c = child(n, goRight);
+    if (n->version.load() != version) {
+      return RETRY;
+    }
+
+    if (c == nullptr) {
+      {
+        std::lock_guard<std::mutex> guard(n->lock);
+        if (n->version.load() != version || child(n, goRight) != nullptr) {
+          return RETRY;
+        }
+        ConcurrentAVLNode* fresh = new ConcurrentAVLNode(val, n);
+        if (goRight) {
+          n->right = fresh;
+        } else {
+          n->left = fresh;
+        }
+      }
+      fixUp(n);
+      return CHANGED;
+    }
+
+    if (c->key == val) {
+      std::lock_guard<std::mutex> guard(c->lock);
+      if ((c->version.load() & ConcurrentAVLNode::UNLINKED) != 0) {
+        return RETRY;
+      }
+      if (c->present.load()) {
+        return UNCHANGED;
+      }
+      c->present = true;
+      return CHANGED;
+    }
+
+    long long childVersion = c->version.load();
+    if ((childVersion & (ConcurrentAVLNode::SHRINKING | ConcurrentAVLNode::UNLINKED)) != 0) {
+      waitUntilNotShrinking(c);
+      return RETRY;
+    }
+    if (child(n, goRight) != c || n->version.load() != version) {
+      return RETRY;
+    }
+
+    n = c;
+    version = childVersion;
+    goRight = val > c->key;
+  }
+}
+
+/*Description: Function descends like attemptSearch and clears the
+  present flag of the node holding val under its lock. The node is
+  physically removed by fixUp if it has fewer than two children.
+  Parameters: int val
+  Returns: Result - CHANGED, UNCHANGED or RETRY
+*/
+ConcurrentAVLTree::Result ConcurrentAVLTree::attemptDelete(int val){
+  ConcurrentAVLNode* n = rootHolder;
+  long long version = n->version.load();
+  bool goRight = true;
+
+  while (true) {
+    ConcurrentAVLNode* c = child(n, goRight);
+    if (n->version.load() != version) {
+      return RETRY;
+    }
+    if (c == nullptr) {
+      return UNCHANGED;
+    }
+
+    if (c->key == val) {
+      {
+        std::lock_guard<std::mutex> guard(c->lock);
+        if ((c->version.load() & ConcurrentAVLNode::UNLINKED) != 0) {
+          return RETRY;
+        }
+        if (!c->present.load()) {
+          return UNCHANGED;
+        }
+        c->present = false;
+      }
+      fixUp(c);
+      return CHANGED;
+    }
+
+    long long childVersion = c->version.load();
+    if ((childVersion & (ConcurrentAVLNode::SHRINKING | ConcurrentAVLNode::UNLINKED)) != 0) {
+      waitUntilNotShrinking(c);
+      return RETRY;
+    }
+    if (child(n, goRight) != c || n->version.load() != version) {
+      return RETRY;
+    }
+
+    n = c;
+    version = childVersion;
+    goRight = val > c->key;
+  }
+}
+
+/*Description: Function walks from n toward the root repairing one node at
+  a time under the locks of that node and its parent. The walk stops at
+  the first node whose height did not change.
+  Parameters: ConcurrentAVLNode* n
+  Returns: void
+*/
+void ConcurrentAVLTree::fixUp(ConcurrentAVLNode* n){
+  while (n != nullptr && n != rootHolder) {
+    ConcurrentAVLNode* next;
+    ConcurrentAVLNode* movedDown = nullptr;
+    ConcurrentAVLNode* movedAside = nullptr;
+    {
+      ConcurrentAVLNode* p = n->parent.load();
+      std::unique_lock<std::mutex> parentGuard(p->lock);
+      if (n->parent.load() != p) {
+        continue; // n was moved by a rotation, try again with its new parent
+      }
+      std::unique_lock<std::mutex> nodeGuard(n->lock);
+      if ((n->version.load() & ConcurrentAVLNode::UNLINKED) != 0) {
+        return;
+      }
+      next = fixNode(p, n, movedDown, movedAside);
+    }
+    // Rotated nodes may now be deleted nodes with one child, or out of
+    // balance, so they are repaired too before the walk goes on from p
+    if (movedAside != nullptr) {
+      fixUp(movedAside);
+    }
+    if (movedDown != nullptr) {
+      fixUp(movedDown);
+    }
+    n = next;
+  }
+}
+
+/*Description: Function repairs n, whose parent is p, with both locked. A
+  deleted node with at most one child is unlinked; a node out of balance
+  is rotated; otherwise its height is refreshed. A rotation moves n below
+  its old child and a double rotation also hands half of that child's
+  subtree away, so either may now need repair: n is returned through
+  movedDown and, after a double rotation, the old child through
+  movedAside.
+  Parameters: ConcurrentAVLNode* p, ConcurrentAVLNode* n,
+  ConcurrentAVLNode* &movedDown, ConcurrentAVLNode* &movedAside
+  Returns: ConcurrentAVLNode* - next node to repair, nullptr to stop
+*/
+ConcurrentAVLNode* ConcurrentAVLTree::fixNode(ConcurrentAVLNode* p, ConcurrentAVLNode* n,
+    ConcurrentAVLNode* &movedDown, ConcurrentAVLNode* &movedAside){
+  ConcurrentAVLNode* l = n->left.load();
+  ConcurrentAVLNode* r = n->right.load();
+
+  if (!n->present.load() && (l == nullptr || r == nullptr)) {
+    ConcurrentAVLNode* c = (l != nullptr) ? l : r;
+    replaceChild(p, n, c);
+    if (c != nullptr) {
+      c->parent = p;
+    }
+    n->version = n->version.load() | ConcurrentAVLNode::UNLINKED;
+    retire(n);
+    return p;
+  }
+
+  int leftHeight = getHeight(l);
+  int rightHeight = getHeight(r);
+
+  if (leftHeight - rightHeight > 1) {
+    std::lock_guard<std::mutex> leftGuard(l->lock);
+    ConcurrentAVLNode* lr = l->right.load();
+    if (getHeight(lr) > getHeight(l->left.load())) {
+      std::lock_guard<std::mutex> innerGuard(lr->lock);
+      rotateLeft(n, l, lr);
+      rotateRight(p, n, lr);
+      movedAside = l;
+    } else {
+      rotateRight(p, n, l);
+    }
+    movedDown = n;
+    return p;
+  }
+
+  if (rightHeight - leftHeight > 1) {
+    std::lock_guard<std::mutex> rightGuard(r->lock);
+    ConcurrentAVLNode* rl = r->left.load();
+    if (getHeight(rl) > getHeight(r->right.load())) {
+      std::lock_guard<std::mutex> innerGuard(rl->lock);
+      rotateRight(n, r, rl);
+      rotateLeft(p, n, rl);
+      movedAside = r;
+    } else {
+      rotateLeft(p, n, r);
+    }
+    movedDown = n;
+    return p;
+  }
+
+  int newHeight = std::max(leftHeight, rightHeight) + 1;
+  if (newHeight == n->height.load()) {
+    return nullptr;
+  }
+  n->height = newHeight;
+  return p;
+}
+
+/*Description: Function points the link of p that held oldChild at
+  newChild.
+  Parameters: ConcurrentAVLNode* p, ConcurrentAVLNode* oldChild,
+  ConcurrentAVLNode* newChild
+  Returns: void
+*/
+void ConcurrentAVLTree::replaceChild(ConcurrentAVLNode* p, ConcurrentAVLNode* oldChild, ConcurrentAVLNode* newChild){
+  if (p->left.load() == oldChild) {
+    p->left = newChild;
+  } else {
+    p->right = newChild;
+  }
+}
+
+/*Description: Function rotates n right so its left child l takes its
+  place under p. p, n and l must be locked. n loses keys, so it is marked
+  shrinking for the duration and gets a new version afterwards.
+  Parameters: ConcurrentAVLNode* p, ConcurrentAVLNode* n, ConcurrentAVLNode* l
+  Returns: void
+*/
+void ConcurrentAVLTree::rotateRight(ConcurrentAVLNode* p, ConcurrentAVLNode* n, ConcurrentAVLNode* l){
+  long long version = n->version.load();
+  n->version = version | ConcurrentAVLNode::SHRINKING;
+
+  ConcurrentAVLNode* lr = l->right.load();
+  n->left = lr;
+  if (lr != nullptr) {
+    lr->parent = n;
+  }
+  l->right = n;
+  n->parent = l;
+  replaceChild(p, n, l);
+  l->parent = p;
+
+  updateHeight(n);
+  updateHeight(l);
+  n->version = version + ConcurrentAVLNode::VERSION_STEP;
+}
+
+/*Description: Mirror of rotateRight, n's right child r takes its place.
+  Parameters: ConcurrentAVLNode* p, ConcurrentAVLNode* n, ConcurrentAVLNode* r
+  Returns: void
+*/
+void ConcurrentAVLTree::rotateLeft(ConcurrentAVLNode* p, ConcurrentAVLNode* n, ConcurrentAVLNode* r){
+  long long version = n->version.load();
+  n->version = version | ConcurrentAVLNode::SHRINKING;
+
+  ConcurrentAVLNode* rl = r->left.load();
+  n->right = rl;
+  if (rl != nullptr) {
+    rl->parent = n;
+  }
+  r->left = n;
+  n->parent = r;
+  replaceChild(p, n, r);
+  r->parent = p;
+
+  updateHeight(n);
+  updateHeight(r);
+  n->version = version + ConcurrentAVLNode::VERSION_STEP;
+}
+
+void ConcurrentAVLTree::updateHeight(ConcurrentAVLNode* n){
+  n->height = std::max(getHeight(n->left.load()), getHeight(n->right.load())) + 1;
+}
+
+void ConcurrentAVLTree::inOrder(ConcurrentAVLNode* n, std::vector<int> &order){
+  if (n != nullptr) {
+    inOrder(n->left.load(), order);
+    if (n->present.load()) {
+      order.push_back(n->key);
+    }
+    inOrder(n->right.load(), order);
+  }
+}
+
+void ConcurrentAVLTree::destroy(ConcurrentAVLNode* n){
+  if (n != nullptr) {
+    destroy(n->left.load());
+    destroy(n->right.load());
+    delete n;
+  }
+}
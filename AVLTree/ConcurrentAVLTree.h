@@ -0,0 +1,95 @@
+// File: ConcurrentAVLTree.h
+// Description: AVL tree of ints that many threads may search, insert into
+// and delete from at once, after Bronson, Casper, Chafi and Olukotun, "A
+// Practical Concurrent Binary Search Tree" (PPoPP 2010).
+//  - Readers take no locks. They validate each step against the version
+//    of the node they came from and restart if a rotation shrank it.
+//  - Writers lock only the nodes they relink, always top down.
+//  - Deletion clears a node's present flag. Nodes with at most one child
+//    are unlinked afterwards, nodes with two children keep routing.
+//  - Rebalancing is relaxed: each update walks up fixing heights and
+//    rotating one node at a time, and stops once a height is unchanged.
+// Unlinked nodes may still be in use by readers, so they are freed by
+// epoch based reclamation: every operation announces the global epoch in a
+// slot while it runs, a node unlinked in epoch e is retired with tag e, and
+// the epoch only advances once every running operation has announced it.
+// By the time the epoch reaches e + 2 no operation can still hold the node,
+// so it is deleted.
+
+#ifndef CONCURRENTAVLTREE_H
+#define CONCURRENTAVLTREE_H
+
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <vector>
+#include "ConcurrentAVLNode.h"
+
+class ConcurrentAVLTree{
+  public:
+    ConcurrentAVLTree();
+    ~ConcurrentAVLTree();
+
+    int getSize();
+
+    bool search(int);
+    bool insertValue(int);
+    bool deleteValue(int);
+
+    void inOrder(std::vector<int>&);
+
+  private:
+    enum Result { RETRY, FOUND, NOT_FOUND, CHANGED, UNCHANGED };
+
+    // Operations running at once beyond this many wait for a free slot
+    static const int epochSlots = 64;
+    // Retired nodes pending before an operation tries to reclaim them
+    static const int reclaimThreshold = 256;
+
+    // One announcement per cache line, 0 while the slot is free
+    struct EpochSlot{
+      std::atomic<unsigned long long> epoch;
+      char pad[64 - sizeof(std::atomic<unsigned long long>)];
+    };
+
+    struct RetiredNode{
+      unsigned long long epoch;
+      ConcurrentAVLNode* node;
+    };
+
+    ConcurrentAVLNode* rootHolder; // sentinel, the tree hangs off its right link
+    std::atomic<int> size;
+    std::atomic<unsigned long long> globalEpoch;
+    EpochSlot slots[epochSlots];
+    std::deque<RetiredNode> retired; // oldest first, epochs never decrease
+    std::atomic<int> retiredCount;
+    std::mutex retiredLock;
+
+    ConcurrentAVLTree(const ConcurrentAVLTree&);
+    ConcurrentAVLTree& operator=(const ConcurrentAVLTree&);
+
+    static ConcurrentAVLNode* child(ConcurrentAVLNode*, bool);
+    static int getHeight(ConcurrentAVLNode*);
+    static void waitUntilNotShrinking(ConcurrentAVLNode*);
+
+    int enterEpoch();
+    void leaveEpoch(int);
+    void retire(ConcurrentAVLNode*);
+    void reclaim();
+
+    Result attemptSearch(int);
+    Result attemptInsert(int);
+    Result attemptDelete(int);
+
+    void fixUp(ConcurrentAVLNode*);
+    ConcurrentAVLNode* fixNode(ConcurrentAVLNode*, ConcurrentAVLNode*, ConcurrentAVLNode*&, ConcurrentAVLNode*&);
+    void replaceChild(ConcurrentAVLNode*, ConcurrentAVLNode*, ConcurrentAVLNode*);
+    void rotateRight(ConcurrentAVLNode*, ConcurrentAVLNode*, ConcurrentAVLNode*);
+    void rotateLeft(ConcurrentAVLNode*, ConcurrentAVLNode*, ConcurrentAVLNode*);
+    static void updateHeight(ConcurrentAVLNode*);
+
+    void inOrder(ConcurrentAVLNode*, std::vector<int>&);
+    void destroy(ConcurrentAVLNode*);
+};
+
+#endif
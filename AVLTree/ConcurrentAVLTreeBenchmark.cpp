@@ -0,0 +1,183 @@
+// File: ConcurrentAVLTreeBenchmark.cpp
+// Description: Measures throughput of ConcurrentAVLTree against an AVLTree
+// guarded by one global mutex, for 1 up to maxThreads threads and for a
+// read heavy (90% search) and a balanced (50% search) mix. Prints one CSV
+// line per structure, mix and thread count:
+//   structure,search_percent,threads,seconds,ops_per_second
+// Then runs a long insert/delete churn on one ConcurrentAVLTree with
+// maxThreads threads and prints a line per round, so peak memory can be
+// seen to level off once unlinked nodes are being reclaimed:
+//   churn,round,total_ops,seconds,size,peak_rss_kb
+// Usage: ./ConcurrentAVLTreeBenchmark [keyRange] [opsPerThread] [maxThreads] [churnRounds]
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+#include <sys/resource.h>
+#include "AVLTree.h"
+#include "ConcurrentAVLTree.h"
+using namespace std;
+
+typedef chrono::steady_clock Clock;
+
+template <typename Tree>
+double runMix(Tree &tree, int threads, int opsPerThread, int keyRange, int searchPercent);
+void report(const char* structure, int searchPercent, int threads, int ops, double seconds);
+void runChurn(int threads, int opsPerThread, int keyRange, int rounds);
+long peakRssKb();
+
+// AVLTree is not thread safe, so the baseline serializes every call.
+class LockedAVLTree{
+  public:
+    bool search(int val){
+      lock_guard<mutex> guard(treeLock);
+      return tree.search(val) != nullptr;
+    }
+    void insertValue(int val){
+      lock_guard<mutex> guard(treeLock);
+      tree.insertValue(val);
+    }
+    void deleteValue(int val){
+      lock_guard<mutex> guard(treeLock);
+      tree.deleteValue(val);
+    }
+  private:
+    AVLTree tree;
+    mutex treeLock;
+};
+
+int main(int argc, char** argv){
+  int keyRange = (argc > 1) ? atoi(argv[1]) : 100000;
+  int opsPerThread = (argc > 2) ? atoi(argv[2]) : 200000;
+  int maxThreads = (argc > 3) ? atoi(argv[3]) : (int)thread::hardware_concurrency();
+  int churnRounds = (argc > 4) ? atoi(argv[4]) : 20;
+  if (maxThreads < 1){
+    maxThreads = 1;
+  }
+  int mixes[] = {90, 50};
+
+  for (int m = 0; m < 2; m++){
+    for (int threads = 1; threads <= maxThreads; threads *= 2){
+      int ops = threads * opsPerThread;
+
+      ConcurrentAVLTree concurrent;
+      for (int i = 0; i < keyRange; i += 2){ concurrent.insertValue(i); }
+      report("ConcurrentAVLTree", mixes[m], threads, ops,
+             runMix(concurrent, threads, opsPerThread, keyRange, mixes[m]));
+
+      LockedAVLTree locked;
+      for (int i = 0; i < keyRange; i += 2){ locked.insertValue(i); }
+      report("LockedAVLTree", mixes[m], threads, ops,
+             runMix(locked, threads, opsPerThread, keyRange, mixes[m]));
+    }
+  }
+
+  runChurn(maxThreads, opsPerThread, keyRange, churnRounds);
+  return 0;
+}
+
+/******************************************************************************
+ * Run threads workers that each perform opsPerThread random operations on    *
+ * tree and return the wall clock time taken. Writes split evenly between     *
+ * insert and delete so the tree stays about half full                        *
+ * tree - Tree & - tree under test, ConcurrentAVLTree or LockedAVLTree        *
+ * threads - int - number of worker threads                                   *
+ * opsPerThread - int - operations performed by each worker                   *
+ * keyRange - int - keys are drawn uniformly from [0, keyRange)               *
+ * searchPercent - int - share of operations that are searches                *
+ * ***************************************************************************/
+template <typename Tree>
+double runMix(Tree &tree, int threads, int opsPerThread, int keyRange, int searchPercent){
+  vector<thread> workers;
+  Clock::time_point start = Clock::now();
+  for (int t = 0; t < threads; t++){
+    workers.push_back(thread([&tree, t, opsPerThread, keyRange, searchPercent](){
+      mt19937 gen(t + 1);
+      uniform_int_distribution<int> pickKey(0, keyRange - 1);
+      uniform_int_distribution<int> pickOp(0, 99);
+      for (int i = 0; i < opsPerThread; i++){
+        int key = pickKey(gen);
+        int op = pickOp(gen);
+        if (op < searchPercent){
+          tree.search(key);
+        } else if ((op & 1) == 0){
+          tree.insertValue(key);
+        } else {
+          tree.deleteValue(key);
+        }
+      }
+    }));
+  }
+  for (int t = 0; t < threads; t++){
+    workers[t].join();
+  }
+  return chrono::duration<double>(Clock::now() - start).count();
+}
+
+/****************************************************************
+ * Print one CSV result line                                    *
+ * structure - const char* - name of the tree measured          *
+ * searchPercent - int - share of operations that are searches  *
+ * threads - int - number of worker threads                     *
+ * ops - int - total operations timed                           *
+ * seconds - double - time taken by all ops                     *
+ * *************************************************************/
+void report(const char* structure, int searchPercent, int threads, int ops, double seconds){
+  cout << structure << "," << searchPercent << "," << threads << "," << seconds << ","
+       << (ops / seconds) << endl;
+}
+
+/******************************************************************************
+ * Run rounds of pure insert/delete traffic on one ConcurrentAVLTree and      *
+ * print the peak resident set after each round. Every delete of a leaf or   *
+ * single child node unlinks it, so without reclamation memory grows with     *
+ * every round; with it the peak stays flat after the first few rounds        *
+ * threads - int - number of worker threads                                   *
+ * opsPerThread - int - operations performed by each worker per round         *
+ * keyRange - int - keys are drawn uniformly from [0, keyRange)               *
+ * rounds - int - number of rounds to run                                     *
+ * ***************************************************************************/
+void runChurn(int threads, int opsPerThread, int keyRange, int rounds){
+  ConcurrentAVLTree tree;
+  for (int i = 0; i < keyRange; i += 2){ tree.insertValue(i); }
+
+  long long totalOps = 0;
+  Clock::time_point start = Clock::now();
+  for (int round = 1; round <= rounds; round++){
+    vector<thread> workers;
+    for (int t = 0; t < threads; t++){
+      workers.push_back(thread([&tree, t, round, threads, opsPerThread, keyRange](){
+        mt19937 gen(round * threads + t);
+        uniform_int_distribution<int> pickKey(0, keyRange - 1);
+        for (int i = 0; i < opsPerThread; i++){
+          int key = pickKey(gen);
+          if ((i & 1) == 0){
+            tree.insertValue(key);
+          } else {
+            tree.deleteValue(key);
+          }
+        }
+      }));
+    }
+    for (int t = 0; t < threads; t++){
+      workers[t].join();
+    }
+    totalOps += (long long)threads * opsPerThread;
+    cout << "churn," << round << "," << totalOps << ","
+         << chrono::duration<double>(Clock::now() - start).count() << ","
+         << tree.getSize() << "," << peakRssKb() << endl;
+  }
+}
+
+/****************************************************************
+ * Return the peak resident set size of this process in KB      *
+ * *************************************************************/
+long peakRssKb(){
+  struct rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+  return usage.ru_maxrss;
+}
@@ -0,0 +1,325 @@
+// File: FrozenAVLTree.cpp
+// Description: File contains construction of the Eytzinger layout, the
+// branchless searches over it, and saving and mapping the layout as a
+// file.
+
+#include <climits>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include "FrozenAVLTree.h"
+#include "StreamBytes.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define FROZEN_MMAP 1
+#endif
+
+#ifdef __GNUC__
+#define FROZEN_PREFETCH(address) __builtin_prefetch(address)
+#define FROZEN_FFS(x) __builtin_ffsll(x)
+#else
+#define FROZEN_PREFETCH(address)
+static int FROZEN_FFS(unsigned long long x){
+  int position = 1;
+  while (x != 0 && (x & 1) == 0) {
+    x >>= 1;
+    position++;
+  }
+  return (x == 0) ? 0 : position;
+}
+#endif
+
+// Number of ints in a 64 byte cache line. Slots 16k..16k + 15 are the
+// descendants of slot k four levels down, so prefetching them one line
+// ahead hides the latency of the next four steps.
+static const int lineInts = 16;
+
+// Number of lookups advanced together by the batch searches.
+static const int batchLanes = 8;
+
+// Slot whose line is prefetched when a walk is at slot k. The index is
+// clamped to the last slot, so the deepest levels, whose descendants lie
+// past the end, never form an out of range pointer. The clamp is a
+// select, not a branch.
+static size_t prefetchSlot(size_t k, int size){
+  size_t ahead = k * lineInts;
+  return (ahead <= (size_t)size) ? ahead : (size_t)size;
+}
+
+// A saved image is a header of one cache line, holding this tag and the
+// number of values as a 64 bit integer, followed by slots 0..size of the
+// array as native ints. Mapping starts on a page boundary, so the array
+// of a mapped image is cache line aligned like a freshly built one.
+static const char imageTag[8] = {'A', 'V', 'L', 'F', 'R', 'O', 'Z', '1'};
+static const int imageHeaderBytes = lineInts * sizeof(int);
+
+// Default constructor, yields an empty snapshot
+FrozenAVLTree::FrozenAVLTree(){
+  data = nullptr;
+  size = 0;
+}
+
+/*Description: Constructor lays out values, which must be sorted in
+  ascending order without repeats, in Eytzinger order. The array is
+  aligned to a cache line.
+  Parameters: const std::vector<int> &sortedValues
+  Returns: N/A
+*/
+FrozenAVLTree::FrozenAVLTree(const std::vector<int> &sortedValues){
+  size = sortedValues.size();
+  int* buffer = new int[size + 1 + lineInts];
+  storage = std::shared_ptr<const int>(buffer, std::default_delete<const int[]>());
+
+  uintptr_t address = reinterpret_cast<uintptr_t>(buffer);
+  int offset = ((lineInts * sizeof(int)) - address % (lineInts * sizeof(int))) % (lineInts * sizeof(int));
+  int* aligned = buffer + offset / sizeof(int);
+  aligned[0] = INT_MIN;
+
+  int next = 0;
+  fill(aligned, sortedValues, next, 1);
+  data = aligned;
+}
+
+/*Description: Function returns number of values in the snapshot.
+  Parameters: N/A
+  Returns: int
+*/
+int FrozenAVLTree::getSize(){
+  return size;
+}
+
+/*Description: Function returns pointer to stored value equal to val.
+  Else returns nullptr.
+  Parameters: int val
+  Returns: const int*
+*/
+const int* FrozenAVLTree::search(int val){
+  const int* found = lowerBound(val);
+  if (found != nullptr && *found == val) {
+    return found;
+  }
+  return nullptr;
+}
+
+/*Description: Function returns pointer to smallest stored value not less
+  than val, or nullptr if there is none. Each step picks the left or
+  right child with a comparison folded into the index, so the loop never
+  mispredicts on the data. When the walk falls off the tree the answer is
+  the last slot where it went left, found by stripping the trailing right
+  turns (1 bits) and one left turn from k. Slot indexes are size_t: a
+  walk ends at up to 2 * size + 1, which overflows int once a snapshot
+  holds 2^30 values.
+  Parameters: int val
+  Returns: const int*
+*/
+const int* FrozenAVLTree::lowerBound(int val){
+  size_t k = 1;
+  while (k <= (size_t)size) {
+    FROZEN_PREFETCH(data + prefetchSlot(k, size));
+    k = 2 * k + (data[k] < val);
+  }
+  k >>= FROZEN_FFS(~k);
+  if (k == 0) {
+    return nullptr;
+  }
+  return &data[k];
+}
+
+/*Description: Function looks up every query and stores a pointer to the
+  matching value, or nullptr, in results.
+  Parameters: const std::vector<int> &queries,
+  std::vector<const int*> &results
+  Returns: void
+*/
+void FrozenAVLTree::searchBatch(const std::vector<int> &queries, std::vector<const int*> &results){
+  lowerBoundBatch(queries, results);
+  for (size_t i = 0; i < queries.size(); i++) {
+    if (results[i] != nullptr && *results[i] != queries[i]) {
+      results[i] = nullptr;
+    }
+  }
+}
+
+/*Description: Function computes lowerBound for every query. Queries are
+  advanced batchLanes at a time in lockstep, one tree level per round, so
+  the loads of different lanes are independent and overlap in memory
+  instead of each lookup waiting on its own chain of misses. Every lane
+  runs the same number of rounds; a lane that has left the tree keeps its
+  k through a select, so the inner loop has no branches the compiler
+  cannot turn into conditional moves or vector blends.
+  Parameters: const std::vector<int> &queries,
+  std::vector<const int*> &results
+  Returns: void
+*/
+void FrozenAVLTree::lowerBoundBatch(const std::vector<int> &queries, std::vector<const int*> &results){
+  int count = queries.size();
+  results.resize(count);
+
+  int levels = 0;
+  while (((size_t)1 << levels) <= (size_t)size) {
+    levels++;
+  }
+
+  int i = 0;
+  for (; i + batchLanes <= count; i += batchLanes) {
+    const int* q = &queries[i];
+    size_t k[batchLanes];
+    for (int lane = 0; lane < batchLanes; lane++) {
+      k[lane] = 1;
+    }
+
+    for (int level = 0; level < levels; level++) {
+      for (int lane = 0; lane < batchLanes; lane++) {
+        int inside = (k[lane] <= (size_t)size);
+        size_t slot = inside ? k[lane] : 0;
+        FROZEN_PREFETCH(data + prefetchSlot(slot, size));
+        size_t step = 2 * k[lane] + (data[slot] < q[lane]);
+        k[lane] = inside ? step : k[lane];
+      }
+    }
+
+    for (int lane = 0; lane < batchLanes; lane++) {
+      size_t slot = k[lane] >> FROZEN_FFS(~k[lane]);
+      results[i + lane] = (slot == 0) ? nullptr : &data[slot];
+    }
+  }
+
+  for (; i < count; i++) {
+    results[i] = lowerBound(queries[i]);
+  }
+}
+
+/*Description: Function appends every value of the snapshot to order in
+  ascending order.
+  Parameters: std::vector<int> &order
+  Returns: void
+*/
+void FrozenAVLTree::inOrder(std::vector<int> &order){
+  inOrder(1, order);
+}
+
+/*Description: Function writes the snapshot to the file at path in the
+  layout it has in memory.
+  Parameters: const std::string &path
+  Returns: bool - false if the file could not be written
+*/
+bool FrozenAVLTree::save(const std::string &path){
+  char header[imageHeaderBytes];
+  uint64_t count = size;
+  std::memset(header, 0, sizeof(header));
+  std::memcpy(header, imageTag, sizeof(imageTag));
+  std::memcpy(header + sizeof(imageTag), &count, sizeof(count));
+
+  std::ofstream out(path.c_str(), std::ios::binary | std::ios::trunc);
+  int sentinel = INT_MIN;
+  out.write(header, sizeof(header));
+  out.write(reinterpret_cast<const char*>(&sentinel), sizeof(int));
+  if (size > 0) {
+    out.write(reinterpret_cast<const char*>(data + 1), size * sizeof(int));
+  }
+  out.close();
+  return !out.fail();
+}
+
+/*Description: Function replaces T with the snapshot saved at path. On
+  systems with mmap the file is mapped read only and searched in place:
+  loading costs O(1) regardless of size, pages are read in on first
+  touch, and copies of T share the mapping, which is unmapped when the
+  last copy is destroyed. Elsewhere the image is read into memory. T is
+  left unchanged if the file is missing or its header or length is wrong.
+  Parameters: const std::string &path, FrozenAVLTree &T
+  Returns: bool - true if T was loaded
+*/
+bool FrozenAVLTree::load(const std::string &path, FrozenAVLTree &T){
+  char header[imageHeaderBytes];
+  uint64_t count = 0;
+#ifdef FROZEN_MMAP
+  int fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    return false;
+  }
+  struct stat info;
+  if (fstat(fd, &info) != 0 || info.st_size < imageHeaderBytes) {
+    close(fd);
+    return false;
+  }
+  size_t length = info.st_size;
+  void* image = mmap(nullptr, length, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  if (image == MAP_FAILED) {
+    return false;
+  }
+  std::shared_ptr<const int> mapping(static_cast<const int*>(image),
+                                     [length](const int* p){ munmap(const_cast<int*>(p), length); });
+
+  std::memcpy(header, image, sizeof(header));
+  std::memcpy(&count, header + sizeof(imageTag), sizeof(count));
+  if (std::memcmp(header, imageTag, sizeof(imageTag)) != 0 || count > INT_MAX ||
+      length != imageHeaderBytes + (count + 1) * sizeof(int)) {
+    return false;
+  }
+
+  T.storage = mapping;
+  T.data = mapping.get() + lineInts;
+  T.size = count;
+  return true;
+#else
+  std::ifstream in(path.c_str(), std::ios::binary);
+  in.read(header, sizeof(header));
+  std::memcpy(&count, header + sizeof(imageTag), sizeof(count));
+  if (!in || std::memcmp(header, imageTag, sizeof(imageTag)) != 0 || count > INT_MAX) {
+    return false;
+  }
+
+  // Same length check as the mapped path, made before allocating
+  if (bytesRemaining(in) != (int64_t)((count + 1) * sizeof(int))) {
+    return false;
+  }
+
+  int* buffer = new int[count + 1 + lineInts];
+  std::shared_ptr<const int> owner(buffer, std::default_delete<const int[]>());
+  uintptr_t address = reinterpret_cast<uintptr_t>(buffer);
+  int offset = ((lineInts * sizeof(int)) - address % (lineInts * sizeof(int))) % (lineInts * sizeof(int));
+  int* aligned = buffer + offset / sizeof(int);
+  in.read(reinterpret_cast<char*>(aligned), (count + 1) * sizeof(int));
+  if (!in) {
+    return false;
+  }
+
+  T.storage = owner;
+  T.data = aligned;
+  T.size = count;
+  return true;
+#endif
+}
+
+/*Description: Function writes sortedValues into slots of the subtree
+  rooted at slot k in order, so that an in order walk of the implicit
+  tree visits them ascending. next is the index of the next value to
+  place.
+  Parameters: int* layout, const std::vector<int> &sortedValues,
+  int &next, size_t k
+  Returns: void
+*/
+void FrozenAVLTree::fill(int* layout, const std::vector<int> &sortedValues, int &next, size_t k){
+  if (k > (size_t)size) {
+    return;
+  }
+  fill(layout, sortedValues, next, 2 * k);
+  layout[k] = sortedValues[next];
+  next = next + 1;
+  fill(layout, sortedValues, next, 2 * k + 1);
+}
+
+void FrozenAVLTree::inOrder(size_t k, std::vector<int> &order){
+  if (k > (size_t)size) {
+    return;
+  }
+  inOrder(2 * k, order);
+  order.push_back(data[k]);
+  inOrder(2 * k + 1, order);
+}
@@ -0,0 +1,43 @@
+// File: FrozenAVLTree.h
+// Description: Immutable snapshot of an AVLTree produced by
+// AVLTree::freeze(). Values are stored in one flat array in Eytzinger
+// (breadth first) order: the children of slot k are slots 2k and 2k + 1.
+// A lookup walks the array without following pointers or taking data
+// dependent branches, and the top levels of the tree share cache lines.
+// Because the array holds no pointers, save() writes it to disk as is and
+// load() maps the file straight back into memory.
+
+#ifndef FROZENAVLTREE_H
+#define FROZENAVLTREE_H
+
+#include <memory>
+#include <string>
+#include <vector>
+
+class FrozenAVLTree{
+  public:
+    FrozenAVLTree();
+    FrozenAVLTree(const std::vector<int>&);
+
+    int getSize();
+
+    const int* search(int);
+    const int* lowerBound(int);
+    void searchBatch(const std::vector<int>&, std::vector<const int*>&);
+    void lowerBoundBatch(const std::vector<int>&, std::vector<const int*>&);
+
+    void inOrder(std::vector<int>&);
+
+    bool save(const std::string&);
+    static bool load(const std::string&, FrozenAVLTree&);
+
+  private:
+    std::shared_ptr<const int> storage; // keeps the array alive, shared by copies
+    const int* data;                    // slot 0 unused, values in slots 1..size
+    int size;
+
+    void fill(int*, const std::vector<int>&, int&, size_t);
+    void inOrder(size_t, std::vector<int>&);
+};
+
+#endif
@@ -0,0 +1,22 @@
+// File: IntervalNode.cpp
+// Description: File contains constructors for IntervalNode.
+
+#include "IntervalNode.h"
+
+IntervalNode::IntervalNode(){
+  lo = 0;
+  hi = 0;
+  maxHigh = 0;
+  height = 0;
+  left = nullptr;
+  right = nullptr;
+}
+
+IntervalNode::IntervalNode(int l, int h){
+  lo = l;
+  hi = h;
+  maxHigh = h;
+  height = 0;
+  left = nullptr;
+  right = nullptr;
+}
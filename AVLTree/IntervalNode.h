@@ -0,0 +1,24 @@
+// File: IntervalNode.h
+// Description: Node of an IntervalTree. Holds the closed interval
+// [lo, hi] and the largest hi found anywhere in its subtree, which lets a
+// query skip every subtree that ends before the query starts.
+
+#ifndef INTERVALNODE_H
+#define INTERVALNODE_H
+
+#include <memory>
+
+class IntervalNode{
+  public:
+    int lo;
+    int hi;
+    int maxHigh; // largest hi in the subtree rooted here
+    signed char height;
+    std::shared_ptr<IntervalNode> left;
+    std::shared_ptr<IntervalNode> right;
+
+    IntervalNode();
+    IntervalNode(int, int);
+};
+
+#endif
@@ -0,0 +1,332 @@
+// File: IntervalTree.cpp
+// Description: File contains constructor for an interval tree and common
+// functions to interact with the tree. Insert, delete, rebalance and the
+// rotations mirror AVLTree; updateNode recomputes maxHigh along with the
+// height wherever AVLTree would recompute the height.
+
+#include <algorithm>
+#include <cstdlib>
+#include "IntervalTree.h"
+
+// Constructor for IntervalTree class
+IntervalTree::IntervalTree(){
+  root = nullptr;
+  size = 0;
+}
+
+/*Description: Function returns pointer to IntervalTree root.
+  Parameters: N/A
+  Returns: std::shared_ptr<IntervalNode>
+*/
+std::shared_ptr<IntervalNode> IntervalTree::getRoot(){
+  return root;
+}
+
+/*Description: Function returns number of intervals stored.
+  Parameters: N/A
+  Returns: int size
+*/
+int IntervalTree::getSize(){
+  return size;
+}
+
+/*Description: Function returns pointer to node holding exactly [lo, hi].
+  Else returns nullptr.
+  Parameters: int lo, int hi
+  Returns: std::shared_ptr<IntervalNode>
+*/
+std::shared_ptr<IntervalNode> IntervalTree::search(int lo, int hi){
+  const std::shared_ptr<IntervalNode>* slot = &root;
+  IntervalNode* n = root.get();
+  while (n != nullptr && (n->lo != lo || n->hi != hi)) {
+    slot = lessThan(n->lo, n->hi, lo, hi) ? &n->right : &n->left;
+    n = slot->get();
+  }
+  return (n == nullptr) ? nullptr : *slot;
+}
+
+/*Description: Function inserts the interval [lo, hi]. Repeat intervals
+  and intervals with lo > hi are not added.
+  Parameters: int lo, int hi
+  Returns: void
+*/
+void IntervalTree::insertInterval(int lo, int hi){
+  if (lo > hi) {
+    return;
+  }
+  root = insertInterval(root, lo, hi);
+}
+
+/*Description: Function inserts [lo, hi] below n and returns the root of
+  the rebalanced subtree.
+  Parameters: std::shared_ptr<IntervalNode> n, int lo, int hi
+  Returns: std::shared_ptr<IntervalNode>
+*/
+std::shared_ptr<IntervalNode> IntervalTree::insertInterval(std::shared_ptr<IntervalNode> n, int lo, int hi){
+  if (n == nullptr) {
+    size = size + 1;
+    return std::make_shared<IntervalNode>(lo, hi);
+  }
+
+  if (lessThan(n->lo, n->hi, lo, hi)) {
+    n->right = insertInterval(n->right, lo, hi);
+  } else if (lessThan(lo, hi, n->lo, n->hi)) {
+    n->left = insertInterval(n->left, lo, hi);
+  } else {
+    return n;
+  }
+
+  updateNode(n);
+  return rebalance(n);
+}
+
+/*Description: Function removes the interval [lo, hi] if present.
+  Parameters: int lo, int hi
+  Returns: void
+*/
+void IntervalTree::deleteInterval(int lo, int hi){
+  root = deleteInterval(root, lo, hi);
+}
+
+/*Description: Function removes [lo, hi] from below n and returns the root
+  of the rebalanced subtree. A node with two children takes the interval
+  of its successor, which is then removed from the right subtree.
+  Parameters: std::shared_ptr<IntervalNode> n, int lo, int hi
+  Returns: std::shared_ptr<IntervalNode>
+*/
+std::shared_ptr<IntervalNode> IntervalTree::deleteInterval(std::shared_ptr<IntervalNode> n, int lo, int hi){
+  if (n == nullptr) {
+    return n;
+  }
+
+  if (lessThan(n->lo, n->hi, lo, hi)) {
+    n->right = deleteInterval(n->right, lo, hi);
+  } else if (lessThan(lo, hi, n->lo, n->hi)) {
+    n->left = deleteInterval(n->left, lo, hi);
+  } else if (n->left == nullptr || n->right == nullptr) {
+    size = size - 1;
+    return (n->left != nullptr) ? n->left : n->right;
+  } else {
+    IntervalNode* successor = n->right.get();
+    while (successor->left != nullptr) {
+      successor = successor->left.get();
+    }
+    n->lo = successor->lo;
+    n->hi = successor->hi;
+    n->right = deleteInterval(n->right, n->lo, n->hi);
+  }
+
+  updateNode(n);
+  return rebalance(n);
+}
+
+/*Description: Function returns every stored interval that shares at
+  least one point with [lo, hi], in ascending order.
+  Parameters: int lo, int hi
+  Returns: std::vector<std::shared_ptr<IntervalNode>>
+*/
+std::vector<std::shared_ptr<IntervalNode>> IntervalTree::overlapping(int lo, int hi){
+  std::vector<std::shared_ptr<IntervalNode>> result;
+  forEachOverlap(root, lo, hi, [&result](const std::shared_ptr<IntervalNode> &n){ result.push_back(n); });
+  return result;
+}
+
+/*Description: Function returns number of stored intervals that share at
+  least one point with [lo, hi].
+  Parameters: int lo, int hi
+  Returns: int
+*/
+int IntervalTree::countOverlapping(int lo, int hi){
+  int count = 0;
+  overlapping(lo, hi, [&count](const IntervalNode&){ count++; });
+  return count;
+}
+
+/*Description: Function returns true if intervals are in order, every
+  node is AVL balanced with a correct height, and every maxHigh equals the
+  largest hi in its subtree.
+  Parameters: N/A
+  Returns: bool
+*/
+bool IntervalTree::isIntervalTree(){
+  return checkNode(root, nullptr, nullptr) >= -1;
+}
+
+/*Description: Function passes nodes of given tree to a vector in
+  ascending order.
+  Parameters: std::shared_ptr<IntervalNode> n,
+  std::vector<std::shared_ptr<IntervalNode>> &order
+  Returns: void
+*/
+void IntervalTree::inOrder(std::shared_ptr<IntervalNode> n, std::vector<std::shared_ptr<IntervalNode>> &order){
+  if (n != nullptr) {
+    inOrder(n->left, order);
+    order.push_back(n);
+    inOrder(n->right, order);
+  }
+}
+
+// Orders intervals by lo, then by hi.
+bool IntervalTree::lessThan(int lo1, int hi1, int lo2, int hi2){
+  return lo1 < lo2 || (lo1 == lo2 && hi1 < hi2);
+}
+
+/*Description: Function returns height of given node, -1 for nullptr.
+  Parameters: const std::shared_ptr<IntervalNode> &n
+  Returns: int
+*/
+int IntervalTree::getHeight(const std::shared_ptr<IntervalNode> &n){
+  return (n == nullptr) ? -1 : n->height;
+}
+
+/*Description: Function returns height of right subtree minus height of
+  left subtree of n.
+  Parameters: const std::shared_ptr<IntervalNode> &n
+  Returns: int
+*/
+int IntervalTree::getBalanceFactor(const std::shared_ptr<IntervalNode> &n){
+  return getHeight(n->right) - getHeight(n->left);
+}
+
+/*Description: Function recomputes height and maxHigh of n from its
+  children.
+  Parameters: const std::shared_ptr<IntervalNode> &n
+  Returns: void
+*/
+void IntervalTree::updateNode(const std::shared_ptr<IntervalNode> &n){
+  n->height = std::max(getHeight(n->left), getHeight(n->right)) + 1;
+  n->maxHigh = n->hi;
+  if (n->left != nullptr) {
+    n->maxHigh = std::max(n->maxHigh, n->left->maxHigh);
+  }
+  if (n->right != nullptr) {
+    n->maxHigh = std::max(n->maxHigh, n->right->maxHigh);
+  }
+}
+
+/*Description: Function returns height of subtree n, or -2 if the subtree
+  breaks ordering against bounds low and high, balance, a stored height or
+  a stored maxHigh.
+  Parameters: const std::shared_ptr<IntervalNode> &n,
+  const IntervalNode* low, const IntervalNode* high
+  Returns: int
+*/
+int IntervalTree::checkNode(const std::shared_ptr<IntervalNode> &n, const IntervalNode* low, const IntervalNode* high){
+  if (n == nullptr) {
+    return -1;
+  }
+  if ((low != nullptr && !lessThan(low->lo, low->hi, n->lo, n->hi)) ||
+      (high != nullptr && !lessThan(n->lo, n->hi, high->lo, high->hi))) {
+    return -2;
+  }
+  int leftHeight = checkNode(n->left, low, n.get());
+  int rightHeight = checkNode(n->right, n.get(), high);
+  if (leftHeight < -1 || rightHeight < -1 || std::abs(rightHeight - leftHeight) > 1) {
+    return -2;
+  }
+  int maxHigh = n->hi;
+  if (n->left != nullptr) {
+    maxHigh = std::max(maxHigh, n->left->maxHigh);
+  }
+  if (n->right != nullptr) {
+    maxHigh = std::max(maxHigh, n->right->maxHigh);
+  }
+  int height = std::max(leftHeight, rightHeight) + 1;
+  if (n->height != height || n->maxHigh != maxHigh) {
+    return -2;
+  }
+  return height;
+}
+
+/*Description: Function restores the AVL property at n. Returns pointer to
+  the root of the subtree.
+  Parameters: std::shared_ptr<IntervalNode> n
+  Returns: std::shared_ptr<IntervalNode>
+*/
+std::shared_ptr<IntervalNode> IntervalTree::rebalance(std::shared_ptr<IntervalNode> n){
+  int balanceFactor = getBalanceFactor(n);
+  if (balanceFactor == 2 && getBalanceFactor(n->right) >= 0) {
+    return rotateLeft(n);
+  } else if (balanceFactor == 2) {
+    return rotateRightLeft(n);
+  } else if (balanceFactor == -2 && getBalanceFactor(n->left) <= 0) {
+    return rotateRight(n);
+  } else if (balanceFactor == -2) {
+    return rotateLeftRight(n);
+  }
+  return n;
+}
+
+/*Description: Function rotates node left. Function returns pointer to new
+  root of subtree.
+  Parameters: std::shared_ptr<IntervalNode> n
+  Returns: std::shared_ptr<IntervalNode>
+*/
+std::shared_ptr<IntervalNode> IntervalTree::rotateLeft(std::shared_ptr<IntervalNode> n){
+  std::shared_ptr<IntervalNode> temp = n->right;
+  n->right = temp->left;
+  updateNode(n);
+
+  temp->left = n;
+  updateNode(temp);
+
+  return temp;
+}
+
+/*Description: Function rotates node right. Function returns pointer to
+  new root of subtree.
+  Parameters: std::shared_ptr<IntervalNode> n
+  Returns: std::shared_ptr<IntervalNode>
+*/
+std::shared_ptr<IntervalNode> IntervalTree::rotateRight(std::shared_ptr<IntervalNode> n){
+  std::shared_ptr<IntervalNode> temp = n->left;
+  n->left = temp->right;
+  updateNode(n);
+
+  temp->right = n;
+  updateNode(temp);
+
+  return temp;
+}
+
+/*Description: Function rotates node left then right. Function returns
+  pointer to new root of subtree.
+  Parameters: std::shared_ptr<IntervalNode> n
+  Returns: std::shared_ptr<IntervalNode>
+*/
+std::shared_ptr<IntervalNode> IntervalTree::rotateLeftRight(std::shared_ptr<IntervalNode> n){
+  std::shared_ptr<IntervalNode> temp1 = n->left, temp2 = n->left->right;
+
+  //rotate temp1 left, then n right, leaving temp2 on top
+  temp1->right = temp2->left;
+  updateNode(temp1);
+  n->left = temp2->right;
+  updateNode(n);
+
+  temp2->left = temp1;
+  temp2->right = n;
+  updateNode(temp2);
+
+  return temp2;
+}
+
+/*Description: Function rotates node right then left. Function returns
+  pointer to new root of subtree.
+  Parameters: std::shared_ptr<IntervalNode> n
+  Returns: std::shared_ptr<IntervalNode>
+*/
+std::shared_ptr<IntervalNode> IntervalTree::rotateRightLeft(std::shared_ptr<IntervalNode> n){
+  std::shared_ptr<IntervalNode> temp1 = n->right, temp2 = n->right->left;
+
+  //rotate temp1 right, then n left, leaving temp2 on top
+  temp1->left = temp2->right;
+  updateNode(temp1);
+  n->right = temp2->left;
+  updateNode(n);
+
+  temp2->right = temp1;
+  temp2->left = n;
+  updateNode(temp2);
+
+  return temp2;
+}
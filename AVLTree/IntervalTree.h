@@ -0,0 +1,90 @@
+// File: IntervalTree.h
+// Description: AVL tree of closed intervals [lo, hi], ordered by lo and
+// then by hi. Each node also stores the largest hi in its subtree, kept
+// up to date by insert, delete and every rotation, so overlap queries
+// skip every subtree that ends before the query starts. A query reporting
+// k intervals costs O(min(n, (k + 1) log n)), not the O(log n + k) of a
+// priority search tree: matches can sit deep in different subtrees, and
+// the path down to each of them is walked. The trade keeps the tree a
+// plain AVL tree with one extra int per node.
+
+#ifndef INTERVALTREE_H
+#define INTERVALTREE_H
+
+#include <memory>
+#include <vector>
+#include "IntervalNode.h"
+
+class IntervalTree{
+  public:
+    IntervalTree();
+
+    std::shared_ptr<IntervalNode> getRoot();
+    int getSize();
+
+    std::shared_ptr<IntervalNode> search(int, int);
+
+    void insertInterval(int, int);
+    void deleteInterval(int, int);
+
+    /*Description: Function calls visit(const IntervalNode&) once for every
+      stored interval that shares at least one point with [lo, hi], in
+      ascending order. Nothing is collected, so callers can count or filter
+      results as they arrive. There is no early exit: every overlapping
+      interval is visited. Runs in O(min(n, (k + 1) log n)) for k results.
+      Parameters: int lo, int hi, Visitor visit
+      Returns: void
+    */
+    template <typename Visitor>
+    void overlapping(int lo, int hi, Visitor visit){
+      forEachOverlap(root, lo, hi, [&visit](const std::shared_ptr<IntervalNode> &n){ visit(*n); });
+    }
+
+    std::vector<std::shared_ptr<IntervalNode>> overlapping(int, int);
+    int countOverlapping(int, int);
+
+    bool isIntervalTree();
+
+    void inOrder(std::shared_ptr<IntervalNode>, std::vector<std::shared_ptr<IntervalNode>>&);
+
+  private:
+    std::shared_ptr<IntervalNode> root;
+    int size;
+
+    // Calls visit with the owning pointer of each overlapping node. Every
+    // node visited either matches or lies on the path to a match or on the
+    // boundary path for hi, hence at most (k + 1) log n visits.
+    template <typename Visitor>
+    static void forEachOverlap(const std::shared_ptr<IntervalNode> &n, int lo, int hi, const Visitor &visit){
+      // Nothing below n ends at or after lo
+      if (n == nullptr || n->maxHigh < lo) {
+        return;
+      }
+      forEachOverlap(n->left, lo, hi, visit);
+      // n and everything to its right start after hi
+      if (n->lo > hi) {
+        return;
+      }
+      if (n->hi >= lo) {
+        visit(n);
+      }
+      forEachOverlap(n->right, lo, hi, visit);
+    }
+
+    std::shared_ptr<IntervalNode> insertInterval(std::shared_ptr<IntervalNode>, int, int);
+    std::shared_ptr<IntervalNode> deleteInterval(std::shared_ptr<IntervalNode>, int, int);
+
+    static bool lessThan(int, int, int, int);
+    static int getHeight(const std::shared_ptr<IntervalNode>&);
+    static int getBalanceFactor(const std::shared_ptr<IntervalNode>&);
+    static void updateNode(const std::shared_ptr<IntervalNode>&);
+    static int checkNode(const std::shared_ptr<IntervalNode>&, const IntervalNode*, const IntervalNode*);
+
+    std::shared_ptr<IntervalNode> rebalance(std::shared_ptr<IntervalNode>);
+    std::shared_ptr<IntervalNode> rotateLeft(std::shared_ptr<IntervalNode>);
+    std::shared_ptr<IntervalNode> rotateRight(std::shared_ptr<IntervalNode>);
+    std::shared_ptr<IntervalNode> rotateLeftRight(std::shared_ptr<IntervalNode>);
+    std::shared_ptr<IntervalNode> rotateRightLeft(std::shared_ptr<IntervalNode>);
+};
+
+#endif
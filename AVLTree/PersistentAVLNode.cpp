@@ -0,0 +1,22 @@
+// File: PersistentAVLNode.cpp
+// Description: File contains constructor for PersistentAVLNode. Height and
+// subtree size are derived from the children once, when the node is made.
+
+#include <algorithm>
+#include "PersistentAVLNode.h"
+
+static int heightOf(const std::shared_ptr<const PersistentAVLNode> &n){
+  return (n == nullptr) ? -1 : n->height;
+}
+
+static int sizeOf(const std::shared_ptr<const PersistentAVLNode> &n){
+  return (n == nullptr) ? 0 : n->subtreeSize;
+}
+
+PersistentAVLNode::PersistentAVLNode(int v, std::shared_ptr<const PersistentAVLNode> l,
+                                     std::shared_ptr<const PersistentAVLNode> r)
+  : value(v),
+    height(std::max(heightOf(l), heightOf(r)) + 1),
+    subtreeSize(sizeOf(l) + sizeOf(r) + 1),
+    left(l),
+    right(r) {}
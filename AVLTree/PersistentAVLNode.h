@@ -0,0 +1,22 @@
+// File: PersistentAVLNode.h
+// Description: Immutable node of a PersistentAVLTree. Every field is fixed
+// at construction, so a node can be shared by any number of tree versions
+// and read by any number of threads without synchronization.
+
+#ifndef PERSISTENTAVLNODE_H
+#define PERSISTENTAVLNODE_H
+
+#include <memory>
+
+class PersistentAVLNode{
+  public:
+    const int value;
+    const int height;
+    const int subtreeSize;
+    const std::shared_ptr<const PersistentAVLNode> left;
+    const std::shared_ptr<const PersistentAVLNode> right;
+
+    PersistentAVLNode(int, std::shared_ptr<const PersistentAVLNode>, std::shared_ptr<const PersistentAVLNode>);
+};
+
+#endif
@@ -0,0 +1,237 @@
+// File: PersistentAVLTree.cpp
+// Description: File contains path copying insert and delete for
+// PersistentAVLTree and lookups over its snapshots.
+
+#include "PersistentAVLTree.h"
+
+// Default constructor, yields a snapshot of an empty tree
+PersistentAVLSnapshot::PersistentAVLSnapshot(){
+  root = nullptr;
+}
+
+/*Description: Constructor for a snapshot of the version rooted at r.
+  Parameters: std::shared_ptr<const PersistentAVLNode> r
+  Returns: N/A
+*/
+PersistentAVLSnapshot::PersistentAVLSnapshot(std::shared_ptr<const PersistentAVLNode> r){
+  root = r;
+}
+
+std::shared_ptr<const PersistentAVLNode> PersistentAVLSnapshot::getRoot(){
+  return root;
+}
+
+/*Description: Function returns number of values in the snapshot.
+  Parameters: N/A
+  Returns: int
+*/
+int PersistentAVLSnapshot::getSize(){
+  return (root == nullptr) ? 0 : root->subtreeSize;
+}
+
+/*Description: Function returns pointer to node holding val in this
+  version. Else returns nullptr.
+  Parameters: int val
+  Returns: std::shared_ptr<const PersistentAVLNode>
+*/
+std::shared_ptr<const PersistentAVLNode> PersistentAVLSnapshot::search(int val){
+  const PersistentAVLNode* n = root.get();
+  const std::shared_ptr<const PersistentAVLNode>* slot = &root;
+  while (n != nullptr) {
+    if (val < n->value) {
+      slot = &n->left;
+    } else if (val > n->value) {
+      slot = &n->right;
+    } else {
+      return *slot;
+    }
+    n = slot->get();
+  }
+  return nullptr;
+}
+
+std::shared_ptr<const PersistentAVLNode> PersistentAVLSnapshot::minimum(){
+  std::shared_ptr<const PersistentAVLNode> n = root;
+  while (n != nullptr && n->left != nullptr) {
+    n = n->left;
+  }
+  return n;
+}
+
+std::shared_ptr<const PersistentAVLNode> PersistentAVLSnapshot::maximum(){
+  std::shared_ptr<const PersistentAVLNode> n = root;
+  while (n != nullptr && n->right != nullptr) {
+    n = n->right;
+  }
+  return n;
+}
+
+/*Description: Function appends values of subtree n to order in
+  ascending order.
+  Parameters: std::shared_ptr<const PersistentAVLNode> n,
+  std::vector<int> &order
+  Returns: void
+*/
+void PersistentAVLSnapshot::inOrder(std::shared_ptr<const PersistentAVLNode> n, std::vector<int> &order){
+  if (n != nullptr) {
+    inOrder(n->left, order);
+    order.push_back(n->value);
+    inOrder(n->right, order);
+  }
+}
+
+// Constructor for PersistentAVLTree class
+PersistentAVLTree::PersistentAVLTree(){
+  root = nullptr;
+}
+
+/*Description: Function returns a snapshot of the current version. Costs
+  one atomic load; the snapshot is unaffected by later updates.
+  Parameters: N/A
+  Returns: PersistentAVLSnapshot
+*/
+PersistentAVLSnapshot PersistentAVLTree::snapshot(){
+  return PersistentAVLSnapshot(std::atomic_load(&root));
+}
+
+int PersistentAVLTree::getSize(){
+  return snapshot().getSize();
+}
+
+std::shared_ptr<const PersistentAVLNode> PersistentAVLTree::search(int val){
+  return snapshot().search(val);
+}
+
+/*Description: Function publishes a new version holding val. Nodes off the
+  search path are shared with the previous version.
+  Parameters: int val
+  Returns: void
+*/
+void PersistentAVLTree::insertValue(int val){
+  std::lock_guard<std::mutex> guard(writeLock);
+  bool inserted = false;
+  NodePtr newRoot = insertValue(std::atomic_load(&root), val, inserted);
+  if (inserted) {
+    std::atomic_store(&root, newRoot);
+  }
+}
+
+/*Description: Function publishes a new version without val.
+  Parameters: int val
+  Returns: void
+*/
+void PersistentAVLTree::deleteValue(int val){
+  std::lock_guard<std::mutex> guard(writeLock);
+  bool removed = false;
+  NodePtr newRoot = deleteValue(std::atomic_load(&root), val, removed);
+  if (removed) {
+    std::atomic_store(&root, newRoot);
+  }
+}
+
+int PersistentAVLTree::getHeight(const NodePtr &n){
+  return (n == nullptr) ? -1 : n->height;
+}
+
+/*Description: Function returns a new node holding val over subtrees l and
+  r, rotating if their heights differ by 2. Rotations build new nodes
+  instead of rewiring, because l and r may belong to older versions.
+  Parameters: int val, NodePtr l, NodePtr r
+  Returns: NodePtr
+*/
+PersistentAVLTree::NodePtr PersistentAVLTree::makeBalanced(int val, NodePtr l, NodePtr r){
+  if (getHeight(l) > getHeight(r) + 1) {
+    if (getHeight(l->left) >= getHeight(l->right)) {
+      // single right rotation
+      return std::make_shared<const PersistentAVLNode>(l->value, l->left,
+               std::make_shared<const PersistentAVLNode>(val, l->right, r));
+    }
+    // left right rotation
+    NodePtr lr = l->right;
+    return std::make_shared<const PersistentAVLNode>(lr->value,
+             std::make_shared<const PersistentAVLNode>(l->value, l->left, lr->left),
+             std::make_shared<const PersistentAVLNode>(val, lr->right, r));
+  }
+
+  if (getHeight(r) > getHeight(l) + 1) {
+    if (getHeight(r->right) >= getHeight(r->left)) {
+      // single left rotation
+      return std::make_shared<const PersistentAVLNode>(r->value,
+               std::make_shared<const PersistentAVLNode>(val, l, r->left), r->right);
+    }
+    // right left rotation
+    NodePtr rl = r->left;
+    return std::make_shared<const PersistentAVLNode>(rl->value,
+             std::make_shared<const PersistentAVLNode>(val, l, rl->left),
+             std::make_shared<const PersistentAVLNode>(r->value, rl->right, r->right));
+  }
+
+  return std::make_shared<const PersistentAVLNode>(val, l, r);
+}
+
+/*Description: Function returns root of a copy of subtree n holding val.
+  If val is already present n itself is returned and nothing is copied.
+  Parameters: NodePtr n, int val, bool &inserted
+  Returns: NodePtr
+*/
+PersistentAVLTree::NodePtr PersistentAVLTree::insertValue(NodePtr n, int val, bool &inserted){
+  if (n == nullptr) {
+    inserted = true;
+    return std::make_shared<const PersistentAVLNode>(val, nullptr, nullptr);
+  }
+
+  if (val < n->value) {
+    NodePtr l = insertValue(n->left, val, inserted);
+    return inserted ? makeBalanced(n->value, l, n->right) : n;
+  }
+  if (val > n->value) {
+    NodePtr r = insertValue(n->right, val, inserted);
+    return inserted ? makeBalanced(n->value, n->left, r) : n;
+  }
+  return n;
+}
+
+/*Description: Function returns root of a copy of subtree n without val.
+  If val is absent n itself is returned.
+  Parameters: NodePtr n, int val, bool &removed
+  Returns: NodePtr
+*/
+PersistentAVLTree::NodePtr PersistentAVLTree::deleteValue(NodePtr n, int val, bool &removed){
+  if (n == nullptr) {
+    return nullptr;
+  }
+
+  if (val < n->value) {
+    NodePtr l = deleteValue(n->left, val, removed);
+    return removed ? makeBalanced(n->value, l, n->right) : n;
+  }
+  if (val > n->value) {
+    NodePtr r = deleteValue(n->right, val, removed);
+    return removed ? makeBalanced(n->value, n->left, r) : n;
+  }
+
+  removed = true;
+  if (n->left == nullptr) {
+    return n->right;
+  }
+  if (n->right == nullptr) {
+    return n->left;
+  }
+  NodePtr successor;
+  NodePtr r = deleteMinimum(n->right, successor);
+  return makeBalanced(successor->value, n->left, r);
+}
+
+/*Description: Function returns root of a copy of subtree n without its
+  minimum, which is returned through minimumNode.
+  Parameters: NodePtr n, NodePtr &minimumNode
+  Returns: NodePtr
+*/
+PersistentAVLTree::NodePtr PersistentAVLTree::deleteMinimum(NodePtr n, NodePtr &minimumNode){
+  if (n->left == nullptr) {
+    minimumNode = n;
+    return n->right;
+  }
+  NodePtr l = deleteMinimum(n->left, minimumNode);
+  return makeBalanced(n->value, l, n->right);
+}
@@ -0,0 +1,59 @@
+// File: PersistentAVLTree.h
+// Description: AVL tree that keeps every version. An update copies only
+// the O(log n) nodes on the path it changes and shares the rest with the
+// previous version, then publishes the new root atomically. Readers take
+// a snapshot in O(1) without locking and keep a consistent view for as
+// long as they hold it; a version's nodes are freed when the last
+// snapshot that can reach them is released.
+
+#ifndef PERSISTENTAVLTREE_H
+#define PERSISTENTAVLTREE_H
+
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "PersistentAVLNode.h"
+
+// A read only view of one version of a PersistentAVLTree.
+class PersistentAVLSnapshot{
+  public:
+    PersistentAVLSnapshot();
+    PersistentAVLSnapshot(std::shared_ptr<const PersistentAVLNode>);
+
+    std::shared_ptr<const PersistentAVLNode> getRoot();
+    int getSize();
+
+    std::shared_ptr<const PersistentAVLNode> search(int);
+    std::shared_ptr<const PersistentAVLNode> minimum();
+    std::shared_ptr<const PersistentAVLNode> maximum();
+    void inOrder(std::shared_ptr<const PersistentAVLNode>, std::vector<int>&);
+
+  private:
+    std::shared_ptr<const PersistentAVLNode> root;
+};
+
+class PersistentAVLTree{
+  public:
+    PersistentAVLTree();
+
+    PersistentAVLSnapshot snapshot();
+    int getSize();
+    std::shared_ptr<const PersistentAVLNode> search(int);
+
+    void insertValue(int);
+    void deleteValue(int);
+
+  private:
+    std::shared_ptr<const PersistentAVLNode> root; // read and written only through atomic_load/atomic_store
+    std::mutex writeLock;                          // serializes writers, never taken by readers
+
+    typedef std::shared_ptr<const PersistentAVLNode> NodePtr;
+
+    static int getHeight(const NodePtr&);
+    static NodePtr makeBalanced(int, NodePtr, NodePtr);
+    static NodePtr insertValue(NodePtr, int, bool&);
+    static NodePtr deleteValue(NodePtr, int, bool&);
+    static NodePtr deleteMinimum(NodePtr, NodePtr&);
+};
+
+#endif
@@ -0,0 +1,30 @@
+// File: StreamBytes.h
+// Description: Helper shared by the load functions of AVLTree,
+// FrozenAVLTree and BST. They check the bytes left after a file's header
+// against the count the header claims before allocating room for it, so
+// a corrupt or truncated file is rejected instead of forcing a huge
+// allocation.
+
+#ifndef STREAMBYTES_H
+#define STREAMBYTES_H
+
+#include <cstdint>
+#include <istream>
+
+/*Description: Function returns how many bytes are left in the stream
+  after its current read position, which is left where it was.
+  Parameters: std::istream &in
+  Returns: int64_t - bytes left, or -1 if the stream cannot seek
+*/
+inline int64_t bytesRemaining(std::istream &in){
+  std::streampos start = in.tellg();
+  in.seekg(0, std::ios::end);
+  std::streampos end = in.tellg();
+  in.seekg(start);
+  if (!in || start < 0 || end < start) {
+    return -1;
+  }
+  return (int64_t)(end - start);
+}
+
+#endif
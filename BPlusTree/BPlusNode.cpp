@@ -0,0 +1,19 @@
+// File: BPlusNode.cpp
+// Description: File contains constructors for the BPlusTree node types.
+
+#include "BPlusNode.h"
+
+BPlusNode::BPlusNode(bool leaf){
+  isLeaf = leaf;
+  count = 0;
+}
+
+BPlusLeaf::BPlusLeaf() : BPlusNode(true){
+  next = nullptr;
+}
+
+BPlusInner::BPlusInner() : BPlusNode(false){
+  for (int i = 0; i <= capacity; i++) {
+    children[i] = nullptr;
+  }
+}
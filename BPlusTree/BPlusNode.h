@@ -0,0 +1,39 @@
+// File: BPlusNode.h
+// Description: Node types for BPlusTree. Both kinds of node are sized to
+// 256 bytes (four 64 byte cache lines) for int keys, so one node visit
+// brings in a whole sorted key array instead of a single value. Leaves are
+// chained through next for in order scans.
+
+#ifndef BPLUSNODE_H
+#define BPLUSNODE_H
+
+class BPlusNode{
+  public:
+    bool isLeaf;
+    int count; // number of keys in use
+
+    BPlusNode(bool);
+};
+
+class BPlusLeaf : public BPlusNode{
+  public:
+    static const int capacity = 60;
+
+    int keys[capacity];
+    BPlusLeaf* next;
+
+    BPlusLeaf();
+};
+
+// children[i] holds the keys k with keys[i - 1] <= k < keys[i]
+class BPlusInner : public BPlusNode{
+  public:
+    static const int capacity = 20;
+
+    int keys[capacity];
+    BPlusNode* children[capacity + 1];
+
+    BPlusInner();
+};
+
+#endif
@@ -0,0 +1,488 @@
+// File: BPlusTree.cpp
+// Description: File contains constructor for a B+ tree and common
+// functions to interact with the tree. Every key is stored in a leaf;
+// inner nodes only hold separator keys used to route a search.
+
+#include <algorithm>
+#include "BPlusTree.h"
+
+// Constructor for BPlusTree class
+BPlusTree::BPlusTree(){
+  root = nullptr;
+  size = 0;
+  height = 0;
+}
+
+// Destructor for BPlusTree class
+BPlusTree::~BPlusTree(){
+  destroy(root);
+}
+
+/*Description: Function returns number of keys in BPlusTree.
+  Parameters: N/A
+  Returns: int
+*/
+int BPlusTree::getSize(){
+  return size;
+}
+
+/*Description: Function returns number of levels in BPlusTree, 0 when
+  empty.
+  Parameters: N/A
+  Returns: int
+*/
+int BPlusTree::getHeight(){
+  return height;
+}
+
+/*Description: Function returns pointer to stored key equal to val. Else
+  returns nullptr. The pointer is valid until the next update.
+  Parameters: int val
+  Returns: const int*
+*/
+const int* BPlusTree::search(int val){
+  BPlusLeaf* leaf = findLeaf(val);
+  if (leaf == nullptr) {
+    return nullptr;
+  }
+
+  int i = lowerIndex(leaf->keys, leaf->count, val);
+  if (i < leaf->count && leaf->keys[i] == val) {
+    return &leaf->keys[i];
+  }
+  return nullptr;
+}
+
+/*Description: Function returns pointer to smallest key in BPlusTree, or
+  nullptr if the tree is empty.
+  Parameters: N/A
+  Returns: const int*
+*/
+const int* BPlusTree::minimum(){
+  BPlusLeaf* leaf = firstLeaf();
+  if (leaf == nullptr) {
+    return nullptr;
+  }
+  return &leaf->keys[0];
+}
+
+/*Description: Function returns pointer to largest key in BPlusTree, or
+  nullptr if the tree is empty.
+  Parameters: N/A
+  Returns: const int*
+*/
+const int* BPlusTree::maximum(){
+  BPlusNode* n = root;
+  if (n == nullptr) {
+    return nullptr;
+  }
+  while (!n->isLeaf) {
+    BPlusInner* inner = static_cast<BPlusInner*>(n);
+    n = inner->children[inner->count];
+  }
+  BPlusLeaf* leaf = static_cast<BPlusLeaf*>(n);
+  return &leaf->keys[leaf->count - 1];
+}
+
+/*Description: Function inserts val into BPlusTree. Duplicate values are
+  ignored. When the root splits a new root is added above it, so all
+  leaves stay at the same depth.
+  Parameters: int val
+  Returns: void
+*/
+void BPlusTree::insertValue(int val){
+  if (root == nullptr) {
+    root = new BPlusLeaf();
+    height = 1;
+  }
+
+  int splitKey = 0;
+  BPlusNode* splitNode = nullptr;
+  if (insertValue(root, val, splitKey, splitNode)) {
+    size = size + 1;
+  }
+
+  if (splitNode != nullptr) {
+    BPlusInner* newRoot = new BPlusInner();
+    newRoot->keys[0] = splitKey;
+    newRoot->children[0] = root;
+    newRoot->children[1] = splitNode;
+    newRoot->count = 1;
+    root = newRoot;
+    height = height + 1;
+  }
+}
+
+/*Description: Function removes val from BPlusTree if present. Nodes left
+  less than half full borrow from or merge with a sibling, and the root
+  is dropped once it has a single child.
+  Parameters: int val
+  Returns: void
+*/
+void BPlusTree::deleteValue(int val){
+  if (root == nullptr) {
+    return;
+  }
+
+  if (deleteValue(root, val)) {
+    size = size - 1;
+  }
+
+  if (!root->isLeaf && root->count == 0) {
+    BPlusInner* oldRoot = static_cast<BPlusInner*>(root);
+    root = oldRoot->children[0];
+    delete oldRoot;
+    height = height - 1;
+  } else if (root->isLeaf && root->count == 0) {
+    delete static_cast<BPlusLeaf*>(root);
+    root = nullptr;
+    height = 0;
+  }
+}
+
+/*Description: Function appends every key of BPlusTree to order in
+  ascending order by walking the leaf chain.
+  Parameters: std::vector<int> &order
+  Returns: void
+*/
+void BPlusTree::inOrder(std::vector<int> &order){
+  for (BPlusLeaf* leaf = firstLeaf(); leaf != nullptr; leaf = leaf->next) {
+    order.insert(order.end(), leaf->keys, leaf->keys + leaf->count);
+  }
+}
+
+/*Description: Function appends every key k with lo <= k <= hi to order in
+  ascending order. Costs one descent plus the leaves that hold the range.
+  Parameters: int lo, int hi, std::vector<int> &order
+  Returns: void
+*/
+void BPlusTree::inRange(int lo, int hi, std::vector<int> &order){
+  BPlusLeaf* leaf = findLeaf(lo);
+  if (leaf == nullptr) {
+    return;
+  }
+
+  int i = lowerIndex(leaf->keys, leaf->count, lo);
+  while (leaf != nullptr) {
+    for (; i < leaf->count; i++) {
+      if (leaf->keys[i] > hi) {
+        return;
+      }
+      order.push_back(leaf->keys[i]);
+    }
+    leaf = leaf->next;
+    i = 0;
+  }
+}
+
+/*Description: Function returns number of keys in keys[0..count) less
+  than val. The loop has no data dependent branch, so it runs at a fixed
+  cost over the whole node instead of mispredicting on each key.
+  Parameters: const int* keys, int count, int val
+  Returns: int
+*/
+int BPlusTree::lowerIndex(const int* keys, int count, int val){
+  int index = 0;
+  for (int i = 0; i < count; i++) {
+    index += (keys[i] < val);
+  }
+  return index;
+}
+
+/*Description: Function returns index of the child of inner that may hold
+  val, that is the number of separator keys not greater than val.
+  Parameters: const BPlusInner* inner, int val
+  Returns: int
+*/
+int BPlusTree::childIndex(const BPlusInner* inner, int val){
+  int index = 0;
+  for (int i = 0; i < inner->count; i++) {
+    index += (inner->keys[i] <= val);
+  }
+  return index;
+}
+
+/*Description: Function returns leaf that would hold val, or nullptr if
+  the tree is empty.
+  Parameters: int val
+  Returns: BPlusLeaf*
+*/
+BPlusLeaf* BPlusTree::findLeaf(int val){
+  BPlusNode* n = root;
+  if (n == nullptr) {
+    return nullptr;
+  }
+  while (!n->isLeaf) {
+    BPlusInner* inner = static_cast<BPlusInner*>(n);
+    n = inner->children[childIndex(inner, val)];
+  }
+  return static_cast<BPlusLeaf*>(n);
+}
+
+/*Description: Function returns leftmost leaf, or nullptr if the tree is
+  empty.
+  Parameters: N/A
+  Returns: BPlusLeaf*
+*/
+BPlusLeaf* BPlusTree::firstLeaf(){
+  BPlusNode* n = root;
+  if (n == nullptr) {
+    return nullptr;
+  }
+  while (!n->isLeaf) {
+    n = static_cast<BPlusInner*>(n)->children[0];
+  }
+  return static_cast<BPlusLeaf*>(n);
+}
+
+/*Description: Function inserts val into subtree n. If n had to split, the
+  new right sibling is returned through splitNode and the smallest key it
+  covers through splitKey; else splitNode is set to nullptr.
+  Parameters: BPlusNode* n, int val, int &splitKey, BPlusNode* &splitNode
+  Returns: bool - true if val was not already present
+*/
+bool BPlusTree::insertValue(BPlusNode* n, int val, int &splitKey, BPlusNode* &splitNode){
+  splitNode = nullptr;
+
+  if (n->isLeaf) {
+    BPlusLeaf* leaf = static_cast<BPlusLeaf*>(n);
+    int i = lowerIndex(leaf->keys, leaf->count, val);
+    if (i < leaf->count && leaf->keys[i] == val) {
+      return false;
+    }
+
+    if (leaf->count < BPlusLeaf::capacity) {
+      std::copy_backward(leaf->keys + i, leaf->keys + leaf->count, leaf->keys + leaf->count + 1);
+      leaf->keys[i] = val;
+      leaf->count = leaf->count + 1;
+      return true;
+    }
+
+    // Leaf is full. Lay out the capacity + 1 keys in order and give the
+    // upper half to a new leaf.
+    int keys[BPlusLeaf::capacity + 1];
+    std::copy(leaf->keys, leaf->keys + i, keys);
+    keys[i] = val;
+    std::copy(leaf->keys + i, leaf->keys + leaf->count, keys + i + 1);
+
+    int total = BPlusLeaf::capacity + 1;
+    int leftCount = total / 2;
+    BPlusLeaf* right = new BPlusLeaf();
+    std::copy(keys, keys + leftCount, leaf->keys);
+    leaf->count = leftCount;
+    std::copy(keys + leftCount, keys + total, right->keys);
+    right->count = total - leftCount;
+
+    right->next = leaf->next;
+    leaf->next = right;
+    splitKey = right->keys[0];
+    splitNode = right;
+    return true;
+  }
+
+  BPlusInner* inner = static_cast<BPlusInner*>(n);
+  int index = childIndex(inner, val);
+  int childKey = 0;
+  BPlusNode* childSplit = nullptr;
+  bool inserted = insertValue(inner->children[index], val, childKey, childSplit);
+  if (childSplit == nullptr) {
+    return inserted;
+  }
+
+  if (inner->count < BPlusInner::capacity) {
+    std::copy_backward(inner->keys + index, inner->keys + inner->count, inner->keys + inner->count + 1);
+    std::copy_backward(inner->children + index + 1, inner->children + inner->count + 1,
+                       inner->children + inner->count + 2);
+    inner->keys[index] = childKey;
+    inner->children[index + 1] = childSplit;
+    inner->count = inner->count + 1;
+    return inserted;
+  }
+
+  // Inner node is full. The middle key moves up to the parent, keys on
+  // either side of it stay in this node or go to the new sibling.
+  int keys[BPlusInner::capacity + 1];
+  BPlusNode* children[BPlusInner::capacity + 2];
+  std::copy(inner->keys, inner->keys + index, keys);
+  keys[index] = childKey;
+  std::copy(inner->keys + index, inner->keys + inner->count, keys + index + 1);
+  std::copy(inner->children, inner->children + index + 1, children);
+  children[index + 1] = childSplit;
+  std::copy(inner->children + index + 1, inner->children + inner->count + 1, children + index + 2);
+
+  int total = BPlusInner::capacity + 1;
+  int mid = total / 2;
+  BPlusInner* right = new BPlusInner();
+  std::copy(keys, keys + mid, inner->keys);
+  std::copy(children, children + mid + 1, inner->children);
+  inner->count = mid;
+  std::copy(keys + mid + 1, keys + total, right->keys);
+  std::copy(children + mid + 1, children + total + 1, right->children);
+  right->count = total - mid - 1;
+  for (int i = inner->count + 1; i <= BPlusInner::capacity; i++) {
+    inner->children[i] = nullptr;
+  }
+
+  splitKey = keys[mid];
+  splitNode = right;
+  return inserted;
+}
+
+/*Description: Function removes val from subtree n and repairs any child
+  left under half full on the way back up.
+  Parameters: BPlusNode* n, int val
+  Returns: bool - true if val was removed
+*/
+bool BPlusTree::deleteValue(BPlusNode* n, int val){
+  if (n->isLeaf) {
+    BPlusLeaf* leaf = static_cast<BPlusLeaf*>(n);
+    int i = lowerIndex(leaf->keys, leaf->count, val);
+    if (i == leaf->count || leaf->keys[i] != val) {
+      return false;
+    }
+    std::copy(leaf->keys + i + 1, leaf->keys + leaf->count, leaf->keys + i);
+    leaf->count = leaf->count - 1;
+    return true;
+  }
+
+  BPlusInner* inner = static_cast<BPlusInner*>(n);
+  int index = childIndex(inner, val);
+  bool removed = deleteValue(inner->children[index], val);
+  if (removed) {
+    BPlusNode* child = inner->children[index];
+    int minimumCount = child->isLeaf ? BPlusLeaf::capacity / 2 : BPlusInner::capacity / 2;
+    if (child->count < minimumCount) {
+      fixUnderflow(inner, index);
+    }
+  }
+  return removed;
+}
+
+/*Description: Function restores the minimum fill of child index of
+  parent, by borrowing one key from a sibling that can spare it or else
+  by merging with a sibling and removing their separator from parent.
+  Parameters: BPlusInner* parent, int index
+  Returns: void
+*/
+void BPlusTree::fixUnderflow(BPlusInner* parent, int index){
+  BPlusNode* child = parent->children[index];
+  BPlusNode* left = (index > 0) ? parent->children[index - 1] : nullptr;
+  BPlusNode* right = (index < parent->count) ? parent->children[index + 1] : nullptr;
+
+  // separator between the two nodes being merged, and the node removed
+  int separator;
+  BPlusNode* removedNode;
+
+  if (child->isLeaf) {
+    const int minimumCount = BPlusLeaf::capacity / 2;
+    BPlusLeaf* leaf = static_cast<BPlusLeaf*>(child);
+    BPlusLeaf* leftLeaf = static_cast<BPlusLeaf*>(left);
+    BPlusLeaf* rightLeaf = static_cast<BPlusLeaf*>(right);
+
+    if (leftLeaf != nullptr && leftLeaf->count > minimumCount) {
+      std::copy_backward(leaf->keys, leaf->keys + leaf->count, leaf->keys + leaf->count + 1);
+      leaf->keys[0] = leftLeaf->keys[leftLeaf->count - 1];
+      leaf->count = leaf->count + 1;
+      leftLeaf->count = leftLeaf->count - 1;
+      parent->keys[index - 1] = leaf->keys[0];
+      return;
+    }
+    if (rightLeaf != nullptr && rightLeaf->count > minimumCount) {
+      leaf->keys[leaf->count] = rightLeaf->keys[0];
+      leaf->count = leaf->count + 1;
+      std::copy(rightLeaf->keys + 1, rightLeaf->keys + rightLeaf->count, rightLeaf->keys);
+      rightLeaf->count = rightLeaf->count - 1;
+      parent->keys[index] = rightLeaf->keys[0];
+      return;
+    }
+
+    if (leftLeaf != nullptr) {
+      // merge child into its left sibling
+      std::copy(leaf->keys, leaf->keys + leaf->count, leftLeaf->keys + leftLeaf->count);
+      leftLeaf->count = leftLeaf->count + leaf->count;
+      leftLeaf->next = leaf->next;
+      separator = index - 1;
+      removedNode = leaf;
+    } else {
+      // merge right sibling into child
+      std::copy(rightLeaf->keys, rightLeaf->keys + rightLeaf->count, leaf->keys + leaf->count);
+      leaf->count = leaf->count + rightLeaf->count;
+      leaf->next = rightLeaf->next;
+      separator = index;
+      removedNode = rightLeaf;
+    }
+  } else {
+    const int minimumCount = BPlusInner::capacity / 2;
+    BPlusInner* inner = static_cast<BPlusInner*>(child);
+    BPlusInner* leftInner = static_cast<BPlusInner*>(left);
+    BPlusInner* rightInner = static_cast<BPlusInner*>(right);
+
+    if (leftInner != nullptr && leftInner->count > minimumCount) {
+      // rotate through the parent: separator comes down, left's last key
+      // goes up and left's last child moves across
+      std::copy_backward(inner->keys, inner->keys + inner->count, inner->keys + inner->count + 1);
+      std::copy_backward(inner->children, inner->children + inner->count + 1,
+                         inner->children + inner->count + 2);
+      inner->keys[0] = parent->keys[index - 1];
+      inner->children[0] = leftInner->children[leftInner->count];
+      inner->count = inner->count + 1;
+      parent->keys[index - 1] = leftInner->keys[leftInner->count - 1];
+      leftInner->children[leftInner->count] = nullptr;
+      leftInner->count = leftInner->count - 1;
+      return;
+    }
+    if (rightInner != nullptr && rightInner->count > minimumCount) {
+      inner->keys[inner->count] = parent->keys[index];
+      inner->children[inner->count + 1] = rightInner->children[0];
+      inner->count = inner->count + 1;
+      parent->keys[index] = rightInner->keys[0];
+      std::copy(rightInner->keys + 1, rightInner->keys + rightInner->count, rightInner->keys);
+      std::copy(rightInner->children + 1, rightInner->children + rightInner->count + 1, rightInner->children);
+      rightInner->children[rightInner->count] = nullptr;
+      rightInner->count = rightInner->count - 1;
+      return;
+    }
+
+    BPlusInner* into = (leftInner != nullptr) ? leftInner : inner;
+    BPlusInner* from = (leftInner != nullptr) ? inner : rightInner;
+    separator = (leftInner != nullptr) ? index - 1 : index;
+    into->keys[into->count] = parent->keys[separator];
+    std::copy(from->keys, from->keys + from->count, into->keys + into->count + 1);
+    std::copy(from->children, from->children + from->count + 1, into->children + into->count + 1);
+    into->count = into->count + 1 + from->count;
+    removedNode = from;
+  }
+
+  // drop the separator and the emptied node from parent
+  std::copy(parent->keys + separator + 1, parent->keys + parent->count, parent->keys + separator);
+  std::copy(parent->children + separator + 2, parent->children + parent->count + 1,
+            parent->children + separator + 1);
+  parent->children[parent->count] = nullptr;
+  parent->count = parent->count - 1;
+
+  if (removedNode->isLeaf) {
+    delete static_cast<BPlusLeaf*>(removedNode);
+  } else {
+    delete static_cast<BPlusInner*>(removedNode);
+  }
+}
+
+/*Description: Function frees every node of subtree n.
+  Parameters: BPlusNode* n
+  Returns: void
+*/
+void BPlusTree::destroy(BPlusNode* n){
+  if (n == nullptr) {
+    return;
+  }
+  if (n->isLeaf) {
+    delete static_cast<BPlusLeaf*>(n);
+    return;
+  }
+
+  BPlusInner* inner = static_cast<BPlusInner*>(n);
+  for (int i = 0; i <= inner->count; i++) {
+    destroy(inner->children[i]);
+  }
+  delete inner;
+}
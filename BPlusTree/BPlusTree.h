@@ -0,0 +1,53 @@
+// File: BPlusTree.h
+// Description: In memory B+ tree of ints exposing the same operations as
+// AVLTree (search, insertValue, deleteValue, minimum, maximum, inOrder).
+// Keys live in sorted arrays inside 256 byte nodes, so a lookup costs one
+// cache miss per level of a tree that is only a handful of levels deep.
+
+#ifndef BPLUSTREE_H
+#define BPLUSTREE_H
+
+#include <vector>
+#include "BPlusNode.h"
+
+class BPlusTree{
+  public:
+    BPlusTree();
+    ~BPlusTree();
+
+    int getSize();
+    int getHeight();
+
+    const int* search(int);
+
+    const int* minimum();
+    const int* maximum();
+
+    void insertValue(int);
+    void deleteValue(int);
+
+    void inOrder(std::vector<int>&);
+    void inRange(int, int, std::vector<int>&);
+
+  private:
+    BPlusNode* root;
+    int size;
+    int height;
+
+    BPlusTree(const BPlusTree&);
+    BPlusTree& operator=(const BPlusTree&);
+
+    static int lowerIndex(const int*, int, int);
+    static int childIndex(const BPlusInner*, int);
+
+    BPlusLeaf* findLeaf(int);
+    BPlusLeaf* firstLeaf();
+
+    bool insertValue(BPlusNode*, int, int&, BPlusNode*&);
+    bool deleteValue(BPlusNode*, int);
+    void fixUnderflow(BPlusInner*, int);
+
+    void destroy(BPlusNode*);
+};
+
+#endif
@@ -0,0 +1,148 @@
+// File: BPlusTreeBenchmark.cpp
+// Description: Compares point lookup and range scan throughput of
+// BPlusTree against AVLTree and BST on the same random keys. Prints one
+// CSV line per structure and operation:
+//   structure,operation,n,seconds,ops_per_second
+// Usage: ./BPlusTreeBenchmark [n] [rangeLength]
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+#include "BPlusTree.h"
+#include "AVLTree.h"
+#include "BST.h"
+using namespace std;
+
+typedef chrono::steady_clock Clock;
+
+double secondsSince(Clock::time_point start);
+void report(const char* structure, const char* operation, int n, int ops, double seconds);
+void bstRange(std::shared_ptr<Node> n, int lo, int hi, vector<int> &order);
+
+int main(int argc, char** argv){
+  int n = (argc > 1) ? atoi(argv[1]) : 1000000;
+  int rangeLength = (argc > 2) ? atoi(argv[2]) : 100;
+  int scans = 100000;
+
+  mt19937 gen(311);
+  vector<int> keys(n);
+  for (int i = 0; i < n; i++){
+    keys[i] = i * 4;
+  }
+  shuffle(keys.begin(), keys.end(), gen);
+
+  vector<int> lookups(n);
+  uniform_int_distribution<int> pick(0, n - 1);
+  for (int i = 0; i < n; i++){
+    lookups[i] = keys[pick(gen)];
+  }
+  vector<int> scanStarts(scans);
+  for (int i = 0; i < scans; i++){
+    scanStarts[i] = keys[pick(gen)];
+  }
+  int scanWidth = rangeLength * 4;
+
+  long checksum = 0;
+  vector<int> order;
+  Clock::time_point start;
+
+  // B+ tree
+  BPlusTree bplus;
+  start = Clock::now();
+  for (int i = 0; i < n; i++){ bplus.insertValue(keys[i]); }
+  report("BPlusTree", "insert", n, n, secondsSince(start));
+  start = Clock::now();
+  for (int i = 0; i < n; i++){ checksum += (bplus.search(lookups[i]) != nullptr); }
+  report("BPlusTree", "search", n, n, secondsSince(start));
+  start = Clock::now();
+  for (int i = 0; i < scans; i++){
+    order.clear();
+    bplus.inRange(scanStarts[i], scanStarts[i] + scanWidth, order);
+    checksum += order.size();
+  }
+  report("BPlusTree", "range", n, scans, secondsSince(start));
+
+  // AVL tree
+  AVLTree avl;
+  start = Clock::now();
+  for (int i = 0; i < n; i++){ avl.insertValue(keys[i]); }
+  report("AVLTree", "insert", n, n, secondsSince(start));
+  start = Clock::now();
+  for (int i = 0; i < n; i++){ checksum += (avl.search(lookups[i]) != nullptr); }
+  report("AVLTree", "search", n, n, secondsSince(start));
+  start = Clock::now();
+  for (int i = 0; i < scans; i++){
+    order.clear();
+    AVLTreeIterator last = avl.upperBound(scanStarts[i] + scanWidth);
+    for (AVLTreeIterator it = avl.lowerBound(scanStarts[i]); it != last; ++it){
+      order.push_back(it->value);
+    }
+    checksum += order.size();
+  }
+  report("AVLTree", "range", n, scans, secondsSince(start));
+
+  // BST
+  BST bst;
+  start = Clock::now();
+  for (int i = 0; i < n; i++){ bst.insertValue(keys[i]); }
+  report("BST", "insert", n, n, secondsSince(start));
+  start = Clock::now();
+  for (int i = 0; i < n; i++){ checksum += (bst.search(lookups[i]) != nullptr); }
+  report("BST", "search", n, n, secondsSince(start));
+  start = Clock::now();
+  for (int i = 0; i < scans; i++){
+    order.clear();
+    bstRange(bst.root, scanStarts[i], scanStarts[i] + scanWidth, order);
+    checksum += order.size();
+  }
+  report("BST", "range", n, scans, secondsSince(start));
+
+  cerr << "checksum " << checksum << endl;
+  return 0;
+}
+
+/**********************************************************
+ * Return seconds elapsed since start                     *
+ * start - Clock::time_point - time the measurement began *
+ * *******************************************************/
+double secondsSince(Clock::time_point start){
+  return chrono::duration<double>(Clock::now() - start).count();
+}
+
+/************************************************************
+ * Print one CSV result line                                *
+ * structure - const char* - name of the tree measured      *
+ * operation - const char* - name of the operation measured *
+ * n - int - number of keys in the tree                     *
+ * ops - int - number of operations timed                   *
+ * seconds - double - time taken by all ops                 *
+ * *********************************************************/
+void report(const char* structure, const char* operation, int n, int ops, double seconds){
+  cout << structure << "," << operation << "," << n << "," << seconds << ","
+       << (ops / seconds) << endl;
+}
+
+/**********************************************************************************
+ * Append the values of a BST in [lo, hi] to order, skipping subtrees that cannot *
+ * hold any of them                                                               *
+ * n - std::shared_ptr<Node> - root of the subtree to scan                        *
+ * lo, hi - int - inclusive bounds of the range                                   *
+ * order - vector<int> & - output values in ascending order                       *
+ * *******************************************************************************/
+void bstRange(std::shared_ptr<Node> n, int lo, int hi, vector<int> &order){
+  if (n == nullptr){
+    return;
+  }
+  if (n->value > lo){
+    bstRange(n->left, lo, hi, order);
+  }
+  if (n->value >= lo && n->value <= hi){
+    order.push_back(n->value);
+  }
+  if (n->value < hi){
+    bstRange(n->right, lo, hi, order);
+  }
+}
@@ -0,0 +1,137 @@
+// File: BPlusTreeDriver.cpp
+// Description: Simple main to test B+ tree methods. Uses the same opcodes
+// as the AVL tree driver; traversals other than inorder do not apply.
+
+#include <iostream>
+#include <vector>
+#include "BPlusTree.h"
+using namespace std;
+
+void printVector(const vector<int> &v);
+void printKey(const int* key);
+void runSearch(BPlusTree &T);
+void runInsert(BPlusTree &T);
+void runDelete(BPlusTree &T);
+void runRange(BPlusTree &T);
+
+/***************************************
+ * Simple main to test B+ Tree methods *
+ * ************************************/
+int main(){
+  BPlusTree T;
+
+  int operation;
+  cin >> operation;
+
+  while (operation > 0){
+    vector<int> order;
+    switch(operation){
+      case 1: // search
+        cout << "SEARCH FOR ";
+        runSearch(T);
+        break;
+      case 2: // insert
+        cout << "INSERT ";
+        runInsert(T);
+        break;
+      case 3: // delete
+        cout << "DELETE ";
+        runDelete(T);
+        break;
+      case 5: // inorder
+        cout << "INORDER" << endl;
+        T.inOrder(order);
+        printVector(order);
+        break;
+      case 7: // minimum
+        cout << "MINIMUM" << endl;
+        printKey(T.minimum());
+        break;
+      case 8: // maximum
+        cout << "MAXIMUM" << endl;
+        printKey(T.maximum());
+        break;
+      case 9: // size
+        cout << "SIZE" << endl;
+        cout << T.getSize() << endl;
+        break;
+      case 13: // range scan
+        cout << "RANGE ";
+        runRange(T);
+        break;
+      default:
+        break;
+    }
+    cin >> operation;
+  }
+
+  return 0;
+}
+
+/**********************************************
+ * Print the values in a vector               *
+ * v - const vector<int> & - a vector of keys *
+ * *******************************************/
+void printVector(const vector<int> &v){
+  for (int i = 0; i < v.size(); i++){
+    cout << v[i] << " ";
+  }
+  cout << endl;
+}
+
+/**************************************************************
+ * Print a key returned by the tree, or null if there is none *
+ * key - const int* - a key stored in the tree or nullptr     *
+ * ***********************************************************/
+void printKey(const int* key){
+  if (key != nullptr){ cout << *key << endl; }
+  else{ cout << "null" << endl; }
+}
+
+/***************************************************************************************************
+ * Given a B+ Tree, get a value to search for from the console and apply the B+ Tree search method *
+ * T - BPlusTree & - a B+ Tree                                                                     *
+ * ************************************************************************************************/
+void runSearch(BPlusTree &T){
+  int target;
+  cin >> target;
+  cout << target << endl;
+  const int* key = T.search(target);
+  if (key){ cout << *key << endl; }
+  else{ cout << "Not found" << endl; }
+}
+
+/************************************************************************
+ * Given a B+ Tree, get a value from the console and add it to the tree *
+ * T - BPlusTree & - a B+ Tree                                          *
+ * *********************************************************************/
+void runInsert(BPlusTree &T){
+  int newVal;
+  cin >> newVal;
+  cout << newVal << endl;
+  T.insertValue(newVal);
+}
+
+/******************************************************************************************
+ * Given a B+ Tree, get a value from the console and remove it from the tree if it exists *
+ * T - BPlusTree & - a B+ Tree                                                            *
+ * ***************************************************************************************/
+void runDelete(BPlusTree &T){
+  int remove;
+  cin >> remove;
+  cout << remove << endl;
+  T.deleteValue(remove);
+}
+
+/*******************************************************************************************
+ * Given a B+ Tree, get bounds lo and hi from the console and print the values in [lo, hi] *
+ * T - BPlusTree & - a B+ Tree                                                             *
+ * ****************************************************************************************/
+void runRange(BPlusTree &T){
+  int lo, hi;
+  cin >> lo >> hi;
+  cout << lo << " " << hi << endl;
+  vector<int> order;
+  T.inRange(lo, hi, order);
+  printVector(order);
+}
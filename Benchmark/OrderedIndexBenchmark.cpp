@@ -0,0 +1,393 @@
+// File: OrderedIndexBenchmark.cpp
+// Description: Baseline suite for the ordered indexes in this repository.
+// BST, AVLTree, std::set and std::map<int, int> are each driven through
+// the same phases: n inserts, n searches, n alternating minimum/maximum
+// calls, one in-order walk, then n deletes. Four key orders are replayed:
+//   random       keys 0..n-1 shuffled; searches uniform, deletes reshuffled
+//   sorted       keys ascending for every phase
+//   zipf         random inserts; searches and deletes Zipf distributed
+//                (theta 0.99) over a random popularity order
+//   adversarial  zigzag 0, n-1, 1, n-2, ... for every phase, which makes
+//                a plain BST a path and keeps AVLTree doing double rotations
+// Sizes run through the powers of ten from 1e3 up to maxN (at most 1e8).
+// BST is skipped on sorted and adversarial orders above 1e4 keys, where it
+// is a path and a phase costs O(n^2).
+//
+// Each structure, order and size runs in its own child process where
+// fork is available, so peak RSS belongs to that run alone. It still
+// includes the key arrays (8 bytes per key) and the few MB of the
+// process itself; rss_before_kb is taken after the keys are generated.
+// At most about a million operations per phase are timed one by one for
+// the latency percentiles; throughput covers the whole phase. The in-order
+// phase is one operation, so its latency fields are empty, as is the
+// height of std::set and std::map, which do not expose one. Height is
+// measured after the insert phase. std::map stores a value next to each
+// key, so against std::set it shows what a payload costs a red-black tree.
+// Prints a header row, then one CSV line per structure, order, size and
+// phase:
+//   structure,order,n,phase,ops,seconds,ops_per_second,p50_ns,p99_ns,
+//   p999_ns,height,rss_before_kb,peak_rss_kb
+// Usage: ./OrderedIndexBenchmark [maxN]
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <random>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "AVLTree.h"
+#include "BST.h"
+using namespace std;
+
+#if defined(__unix__) || defined(__APPLE__)
+#define BENCH_FORK 1
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+typedef chrono::steady_clock Clock;
+
+// Largest size BST is run at on orders that turn it into a path.
+static const int bstPathLimit = 10000;
+
+// Most operations timed one by one in a phase.
+static const int latencySamples = 1000000;
+
+enum Order { RANDOM, SORTED, ZIPF, ADVERSARIAL };
+static const char* orderNames[] = {"random", "sorted", "zipf", "adversarial"};
+
+// Adapters giving the four structures one interface.
+struct BSTIndex{
+  BST tree;
+  void insert(int k){ tree.insertValue(k); }
+  bool contains(int k){ return tree.search(k) != nullptr; }
+  void erase(int k){ tree.deleteValue(k); }
+  int minimum(){ return tree.minimum()->value; }
+  int maximum(){ return tree.maximum()->value; }
+  long long inOrderSum(){
+    vector<shared_ptr<Node>> order;
+    tree.inOrder(tree.root, order);
+    long long sum = 0;
+    for (size_t i = 0; i < order.size(); i++){ sum += order[i]->value; }
+    return sum;
+  }
+  int height(){ return tree.treeStats().height; }
+};
+
+struct AVLTreeIndex{
+  AVLTree tree;
+  void insert(int k){ tree.insertValue(k); }
+  bool contains(int k){ return tree.search(k) != nullptr; }
+  void erase(int k){ tree.deleteValue(k); }
+  int minimum(){ return tree.minimum()->value; }
+  int maximum(){ return tree.maximum()->value; }
+  long long inOrderSum(){
+    long long sum = 0;
+    for (AVLTreeIterator it = tree.begin(); it != tree.end(); ++it){ sum += it->value; }
+    return sum;
+  }
+  int height(){ return tree.treeStats().height; }
+};
+
+struct SetIndex{
+  set<int> tree;
+  void insert(int k){ tree.insert(k); }
+  bool contains(int k){ return tree.find(k) != tree.end(); }
+  void erase(int k){ tree.erase(k); }
+  int minimum(){ return *tree.begin(); }
+  int maximum(){ return *tree.rbegin(); }
+  long long inOrderSum(){
+    long long sum = 0;
+    for (set<int>::iterator it = tree.begin(); it != tree.end(); ++it){ sum += *it; }
+    return sum;
+  }
+  int height(){ return -1; }
+};
+
+struct MapIndex{
+  map<int, int> tree;
+  void insert(int k){ tree.insert(make_pair(k, k)); }
+  bool contains(int k){ return tree.find(k) != tree.end(); }
+  void erase(int k){ tree.erase(k); }
+  int minimum(){ return tree.begin()->first; }
+  int maximum(){ return tree.rbegin()->first; }
+  long long inOrderSum(){
+    long long sum = 0;
+    for (map<int, int>::iterator it = tree.begin(); it != tree.end(); ++it){ sum += it->second; }
+    return sum;
+  }
+  int height(){ return -1; }
+};
+
+// Result of one phase, printed once the run's peak RSS is known.
+struct PhaseResult{
+  const char* phase;
+  long long ops;
+  double seconds;
+  vector<double> latencies; // nanoseconds, sampled operations only
+};
+
+void runIsolated(int structure, Order order, int n);
+void runStructure(int structure, Order order, int n);
+template <class Index>
+void runPhases(const char* structure, Order order, int n);
+template <class Operation>
+void timePhase(PhaseResult &result, const char* phase, int n, Operation operation);
+void makeKeys(Order order, int n, vector<int> &inserts, vector<int> &searches, vector<int> &deletes);
+void zipfKeys(const vector<int> &keysByRank, vector<int> &requests, mt19937 &gen);
+long peakRssKb();
+string percentile(vector<double> &latencies, double fraction);
+
+int main(int argc, char** argv){
+  long long maxN = (argc > 1) ? atoll(argv[1]) : 1000000;
+  maxN = min(maxN, 100000000LL);
+
+  // Printed here, before any child is forked, so it appears once
+  cout << "structure,order,n,phase,ops,seconds,ops_per_second,p50_ns,p99_ns,"
+       << "p999_ns,height,rss_before_kb,peak_rss_kb" << endl;
+  for (long long n = 1000; n <= maxN; n *= 10){
+    for (int order = RANDOM; order <= ADVERSARIAL; order++){
+      for (int structure = 0; structure < 4; structure++){
+        if (structure == 0 && (order == SORTED || order == ADVERSARIAL) && n > bstPathLimit){
+          cerr << "skipping BST " << orderNames[order] << " " << n << endl;
+          continue;
+        }
+        runIsolated(structure, (Order)order, (int)n);
+      }
+    }
+  }
+  return 0;
+}
+
+/****************************************************************
+ * Run one structure, order and size, in a child process when   *
+ * fork is available so its peak RSS is its own                 *
+ * structure - int - 0 BST, 1 AVLTree, 2 std::set, 3 std::map   *
+ * order - Order - key order replayed                           *
+ * n - int - number of keys                                     *
+ * *************************************************************/
+void runIsolated(int structure, Order order, int n){
+#ifdef BENCH_FORK
+  cout.flush();
+  cerr.flush();
+  pid_t child = fork();
+  if (child == 0){
+    runStructure(structure, order, n);
+    cout.flush();
+    _exit(0);
+  }
+  int status = 0;
+  if (child < 0 || waitpid(child, &status, 0) < 0 || !WIFEXITED(status) || WEXITSTATUS(status) != 0){
+    cerr << "run failed: structure " << structure << " " << orderNames[order] << " " << n << endl;
+  }
+#else
+  runStructure(structure, order, n);
+#endif
+}
+
+/****************************************************************
+ * Dispatch to runPhases with the adapter for structure         *
+ * structure - int - 0 BST, 1 AVLTree, 2 std::set, 3 std::map   *
+ * order - Order - key order replayed                           *
+ * n - int - number of keys                                     *
+ * *************************************************************/
+void runStructure(int structure, Order order, int n){
+  if (structure == 0){
+    runPhases<BSTIndex>("BST", order, n);
+  } else if (structure == 1){
+    runPhases<AVLTreeIndex>("AVLTree", order, n);
+  } else if (structure == 2){
+    runPhases<SetIndex>("std::set", order, n);
+  } else {
+    runPhases<MapIndex>("std::map", order, n);
+  }
+}
+
+/****************************************************************
+ * Time every phase on a fresh index and print the results      *
+ * structure - const char* - name printed in the first column   *
+ * order - Order - key order replayed                           *
+ * n - int - number of keys                                     *
+ * *************************************************************/
+template <class Index>
+void runPhases(const char* structure, Order order, int n){
+  vector<int> inserts, searches, deletes;
+  makeKeys(order, n, inserts, searches, deletes);
+  long rssBefore = peakRssKb();
+
+  long long checksum = 0;
+  vector<PhaseResult> results(5);
+  Index index;
+
+  timePhase(results[0], "insert", n, [&](int i){ index.insert(inserts[i]); });
+  int height = index.height();
+  timePhase(results[1], "search", n, [&](int i){ checksum += index.contains(searches[i]); });
+  timePhase(results[2], "minmax", n, [&](int i){ checksum += (i & 1) ? index.maximum() : index.minimum(); });
+
+  results[3].phase = "inorder";
+  results[3].ops = n;
+  Clock::time_point start = Clock::now();
+  checksum += index.inOrderSum();
+  results[3].seconds = chrono::duration<double>(Clock::now() - start).count();
+
+  timePhase(results[4], "delete", n, [&](int i){ index.erase(deletes[i]); });
+
+  long rssPeak = peakRssKb();
+  for (size_t p = 0; p < results.size(); p++){
+    PhaseResult &r = results[p];
+    cout << structure << "," << orderNames[order] << "," << n << "," << r.phase << ","
+         << r.ops << "," << r.seconds << "," << (r.ops / r.seconds) << ","
+         << percentile(r.latencies, 0.5) << "," << percentile(r.latencies, 0.99) << ","
+         << percentile(r.latencies, 0.999) << ","
+         << (height >= 0 ? to_string(height) : string()) << ","
+         << rssBefore << "," << rssPeak << endl;
+  }
+  cerr << "checksum " << structure << " " << orderNames[order] << " " << n << " " << checksum << endl;
+}
+
+/****************************************************************
+ * Run operation(i) for i from 0 to n - 1, timing the whole     *
+ * loop and every stride-th call on its own so at most about    *
+ * latencySamples latencies are kept                            *
+ * result - PhaseResult & - filled with the timings             *
+ * phase - const char* - name of the phase                      *
+ * n - int - number of operations                               *
+ * operation - Operation - runs operation i                     *
+ * *************************************************************/
+template <class Operation>
+void timePhase(PhaseResult &result, const char* phase, int n, Operation operation){
+  int stride = max(1, n / latencySamples);
+  result.phase = phase;
+  result.ops = n;
+  result.latencies.reserve(n / stride + 1);
+
+  Clock::time_point start = Clock::now();
+  for (int i = 0; i < n; i++){
+    if (i % stride == 0){
+      Clock::time_point opStart = Clock::now();
+      operation(i);
+      result.latencies.push_back(chrono::duration<double, nano>(Clock::now() - opStart).count());
+    } else {
+      operation(i);
+    }
+  }
+  result.seconds = chrono::duration<double>(Clock::now() - start).count();
+}
+
+/****************************************************************
+ * Build the key sequences of each phase for an order           *
+ * order - Order - key order replayed                           *
+ * n - int - number of keys                                     *
+ * inserts - vector<int> & - keys in insertion order            *
+ * searches - vector<int> & - keys looked up                    *
+ * deletes - vector<int> & - keys deleted                       *
+ * *************************************************************/
+void makeKeys(Order order, int n, vector<int> &inserts, vector<int> &searches, vector<int> &deletes){
+  mt19937 gen(50 + order);
+  inserts.resize(n);
+  for (int i = 0; i < n; i++){
+    inserts[i] = i;
+  }
+
+  if (order == RANDOM || order == ZIPF){
+    shuffle(inserts.begin(), inserts.end(), gen);
+  } else if (order == ADVERSARIAL){
+    for (int i = 0; i < n; i++){
+      inserts[i] = (i % 2 == 0) ? i / 2 : n - 1 - i / 2;
+    }
+  }
+
+  searches.resize(n);
+  deletes.resize(n);
+  if (order == RANDOM){
+    for (int i = 0; i < n; i++){
+      searches[i] = gen() % n;
+    }
+    deletes = inserts;
+    shuffle(deletes.begin(), deletes.end(), gen);
+  } else if (order == ZIPF){
+    // the shuffled insert order doubles as the popularity order
+    zipfKeys(inserts, searches, gen);
+    zipfKeys(inserts, deletes, gen);
+  } else {
+    searches = inserts;
+    deletes = inserts;
+  }
+}
+
+/****************************************************************
+ * Fill requests with keys drawn with Zipf skew 0.99, using the *
+ * generator of Gray et al. so no table of n probabilities is   *
+ * needed at 1e8 keys                                           *
+ * keysByRank - const vector<int> & - keys ordered by           *
+ *   popularity                                                 *
+ * requests - vector<int> & - keys drawn, sized by the caller   *
+ * gen - mt19937 & - random source                              *
+ * *************************************************************/
+void zipfKeys(const vector<int> &keysByRank, vector<int> &requests, mt19937 &gen){
+  const double theta = 0.99;
+  int n = keysByRank.size();
+  double zetaN = 0;
+  for (int r = 1; r <= n; r++){
+    zetaN += 1.0 / pow(r, theta);
+  }
+  double zeta2 = 1.0 + pow(0.5, theta);
+  double alpha = 1.0 / (1.0 - theta);
+  double eta = (1.0 - pow(2.0 / n, 1.0 - theta)) / (1.0 - zeta2 / zetaN);
+
+  uniform_real_distribution<double> pick(0.0, 1.0);
+  for (size_t i = 0; i < requests.size(); i++){
+    double u = pick(gen);
+    double uz = u * zetaN;
+    long long rank;
+    if (uz < 1.0){
+      rank = 0;
+    } else if (uz < zeta2){
+      rank = 1;
+    } else {
+      rank = (long long)(n * pow(eta * u - eta + 1.0, alpha));
+    }
+    requests[i] = keysByRank[min<long long>(rank, n - 1)];
+  }
+}
+
+/****************************************************************
+ * Return the peak resident set size of this process in KB, or  *
+ * 0 where it cannot be read                                    *
+ * *************************************************************/
+long peakRssKb(){
+#ifdef BENCH_FORK
+  struct rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+#ifdef __APPLE__
+  return usage.ru_maxrss / 1024; // bytes on macOS
+#else
+  return usage.ru_maxrss;
+#endif
+#else
+  return 0;
+#endif
+}
+
+/****************************************************************
+ * Return the given percentile of the sampled latencies,        *
+ * formatted for the CSV, or an empty field if there are none   *
+ * latencies - vector<double> & - samples in ns, reordered      *
+ * fraction - double - percentile as a fraction, e.g. 0.99      *
+ * *************************************************************/
+string percentile(vector<double> &latencies, double fraction){
+  if (latencies.empty()){
+    return string();
+  }
+  size_t k = min(latencies.size() - 1, (size_t)(fraction * latencies.size()));
+  nth_element(latencies.begin(), latencies.begin() + k, latencies.end());
+  ostringstream out;
+  out << latencies[k];
+  return out.str();
+}
@@ -4,23 +4,222 @@
 // functions to interact with the BST.
 
 #include<iostream>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <utility>
 #include <vector>
 #include <limits.h>
 #include "BST.h"
+#include "StreamBytes.h"
 
 using std::cout;
 using std:: endl;
 
+#ifdef TREE_STATS
+#define BST_STAT_ADD(field, n) (counters.field += (n))
+#else
+#define BST_STAT_ADD(field, n) ((void)0)
+#endif
+#define BST_STAT(field) BST_STAT_ADD(field, 1)
+
+#ifdef __GNUC__
+#define BST_PREFETCH(address) __builtin_prefetch(address)
+#else
+#define BST_PREFETCH(address)
+#endif
+
 
 // constructor for BST
 BST::BST(){
   root = nullptr;
   size = 0;
+  counters = BSTStats();
+  multiset = false;
+  lazyDelete = false;
+  tombstones = 0;
+  rebuildThreshold = 0.5;
 }
 
 // Destructor for BST
 BST::~BST(){}
 
+/*Description: Function turns multiset mode on or off. In multiset mode
+  inserting a value already present increments the count of its node
+  and deleting it decrements the count, removing the node at zero, so
+  memory stays proportional to the number of distinct values and size
+  counts every copy. Turning the mode off keeps existing counts but
+  stops further increments. save stores distinct values only.
+  Parameters: bool enabled
+  Returns: void
+*/
+void BST::setMultiset(bool enabled){
+  multiset = enabled;
+}
+
+/*Description: Function turns lazy delete mode on or off. In lazy mode
+  deleting the last copy of a value only marks its node as a tombstone
+  (count 0) after an O(depth) search, leaving the shape untouched.
+  Searches treat tombstones as absent and inserting the value again
+  revives the node. Once tombstones make up more than the rebuild
+  threshold of all nodes, the delete that crossed it calls rebuild(), so
+  the O(n) rebuild is paid for by the deletes before it. Turning the mode
+  off rebuilds right away if any tombstones are left.
+  Parameters: bool enabled
+  Returns: void
+*/
+void BST::setLazyDelete(bool enabled){
+  lazyDelete = enabled;
+  if (!lazyDelete && tombstones > 0) {
+    rebuild();
+  }
+}
+
+/*Description: Function sets the fraction of nodes, between 0 and 1, that
+  may be tombstones before lazy deletes trigger rebuild(). In multiset
+  mode every live copy counts as a node. The default is 0.5.
+  Parameters: double threshold
+  Returns: void
+*/
+void BST::setRebuildThreshold(double threshold){
+  rebuildThreshold = threshold;
+}
+
+/*Description: Function returns number of tombstones in BST.
+  Parameters: N/A
+  Returns: int
+*/
+int BST::getTombstones(){
+  return tombstones;
+}
+
+/*Description: Function links nodes[lo..hi], which are in ascending order,
+  into a balanced subtree and returns its root. No nodes are allocated.
+  Parameters: const std::vector<std::shared_ptr<Node>> &nodes, int lo,
+  int hi
+  Returns: std::shared_ptr<Node>
+*/
+static std::shared_ptr<Node> linkBalanced(const std::vector<std::shared_ptr<Node>> &nodes, int lo, int hi){
+  if (lo > hi) {
+    return nullptr;
+  }
+  int mid = lo + (hi - lo) / 2;
+  nodes[mid]->left = linkBalanced(nodes, lo, mid - 1);
+  nodes[mid]->right = linkBalanced(nodes, mid + 1, hi);
+  return nodes[mid];
+}
+
+/*Description: Function drops every tombstone and relinks the remaining
+  nodes into a balanced tree of height about log n in O(n) time. Nodes
+  are reused, not copied. The walk uses an explicit stack, and all links
+  are cleared before tombstones are released, so degenerate trees overflow
+  neither the walk nor the destructors.
+  Parameters: N/A
+  Returns: void
+*/
+void BST::rebuild(){
+  std::vector<std::shared_ptr<Node>> nodes;
+  std::vector<const std::shared_ptr<Node>*> stack;
+  const std::shared_ptr<Node>* slot = &root;
+  while (*slot != nullptr || !stack.empty()) {
+    while (*slot != nullptr) {
+      stack.push_back(slot);
+      slot = &(*slot)->left;
+    }
+    slot = stack.back();
+    stack.pop_back();
+    nodes.push_back(*slot);
+    slot = &(*slot)->right;
+  }
+
+  for (size_t i = 0; i < nodes.size(); i++) {
+    nodes[i]->left = nullptr;
+    nodes[i]->right = nullptr;
+  }
+  root = nullptr;
+
+  size_t live = 0;
+  for (size_t i = 0; i < nodes.size(); i++) {
+    if (nodes[i]->count > 0) {
+      nodes[live] = nodes[i];
+      live = live + 1;
+    }
+  }
+  nodes.resize(live);
+
+  root = linkBalanced(nodes, 0, (int)nodes.size() - 1);
+  tombstones = 0;
+}
+
+/*Description: Function returns the node holding the smallest live value
+  if smallest is true, else the largest. Walks in order, or in reverse
+  order, with an explicit stack and stops at the first node that is not
+  a tombstone.
+  Parameters: bool smallest
+  Returns: std::shared_ptr<Node>
+*/
+std::shared_ptr<Node> BST::liveExtreme(bool smallest){
+  std::vector<const std::shared_ptr<Node>*> stack;
+  const std::shared_ptr<Node>* slot = &root;
+  while (*slot != nullptr || !stack.empty()) {
+    while (*slot != nullptr) {
+      stack.push_back(slot);
+      slot = smallest ? &(*slot)->left : &(*slot)->right;
+    }
+    slot = stack.back();
+    stack.pop_back();
+    if ((*slot)->count > 0) {
+      return *slot;
+    }
+    slot = smallest ? &(*slot)->right : &(*slot)->left;
+  }
+  return nullptr;
+}
+
+/*Description: Function returns number of copies of val in BST, 0 if val
+  is absent.
+  Parameters: int val
+  Returns: int
+*/
+int BST::count(int val){
+  Node* n = root.get();
+  while (n != nullptr && n->value != val) {
+    n = (n->value < val) ? n->right.get() : n->left.get();
+  }
+  return (n == nullptr) ? 0 : n->count;
+}
+
+/*Description: Function returns number of values v in BST with
+  lo <= v <= hi, counting every copy. Subtrees entirely outside the range
+  are skipped, so the cost is O(h + k) for height h and k distinct values
+  in range. Uses an explicit stack so degenerate trees do not overflow
+  the call stack.
+  Parameters: int lo, int hi
+  Returns: int
+*/
+int BST::countInRange(int lo, int hi){
+  int total = 0;
+  std::vector<Node*> stack;
+  if (root != nullptr) {
+    stack.push_back(root.get());
+  }
+  while (!stack.empty()) {
+    Node* n = stack.back();
+    stack.pop_back();
+    if (n->value >= lo && n->value <= hi) {
+      total = total + n->count;
+    }
+    if (n->left != nullptr && n->value > lo) {
+      stack.push_back(n->left.get());
+    }
+    if (n->right != nullptr && n->value < hi) {
+      stack.push_back(n->right.get());
+    }
+  }
+  return total;
+}
+
 /*Description: Function calls search(std::shared_ptr<Node> n, int target)
   Returns pointer to node with value matching input target. Else
   return nullptr.
@@ -29,6 +228,7 @@ BST::~BST(){}
 */
 
 std::shared_ptr<Node> BST::search(int target){
+  BST_STAT(searches);
   if (root != nullptr) {
     return search(root, target);
   }
@@ -43,8 +243,10 @@ std::shared_ptr<Node> BST::search(int target){
 */
 std::shared_ptr<Node> BST::search(std::shared_ptr<Node> n, int target){
   if (n != nullptr) {
+    BST_STAT(nodesVisited);
+    BST_STAT_ADD(comparisons, (n->value == target) ? 1 : 2);
     if (n->value == target) {
-      return n;
+      return (n->count > 0) ? n : nullptr; // tombstones read as absent
     } else if (n->value < target) {
         return search(n->right,target);
       } else {
@@ -55,11 +257,74 @@ std::shared_ptr<Node> BST::search(std::shared_ptr<Node> n, int target){
   return nullptr;
 }
 
+/*Description: Function searches for every query and stores the matching
+  node, or nullptr, in results. Up to group searches (at most
+  maxSearchGroup) run interleaved: each takes one step down, prefetches
+  the child it reached and yields to the next, so their cache misses
+  overlap. A finished search is replaced by the next query.
+  Parameters: const std::vector<int> &queries,
+  std::vector<std::shared_ptr<Node>> &results, int group
+  Returns: void
+*/
+void BST::searchBatch(const std::vector<int> &queries, std::vector<std::shared_ptr<Node>> &results, int group){
+  int count = queries.size();
+  results.assign(count, nullptr);
+  if (group > maxSearchGroup) {
+    group = maxSearchGroup;
+  }
+  if (group < 1) {
+    group = 1;
+  }
+
+  const std::shared_ptr<Node>* slot[maxSearchGroup]; // link each search has reached
+  int query[maxSearchGroup];                         // index of its query
+  int active = 0;
+  int next = 0;
+  for (; active < group && next < count; active++) {
+    slot[active] = &root;
+    query[active] = next++;
+  }
+
+  while (active > 0) {
+    int i = 0;
+    while (i < active) {
+      Node* n = slot[i]->get();
+      int target = queries[query[i]];
+      if (n != nullptr) {
+        BST_STAT(nodesVisited);
+        BST_STAT_ADD(comparisons, (n->value == target) ? 1 : 2);
+      }
+      if (n == nullptr || n->value == target) {
+        BST_STAT(searches);
+        if (n != nullptr && n->count > 0) {
+          results[query[i]] = *slot[i];
+        }
+        if (next < count) {
+          slot[i] = &root;
+          query[i] = next++;
+          i++;
+        } else {
+          active--;
+          slot[i] = slot[active];
+          query[i] = query[active];
+        }
+        continue;
+      }
+      slot[i] = (n->value < target) ? &n->right : &n->left;
+      BST_PREFETCH(slot[i]->get());
+      i++;
+    }
+  }
+}
+
 /*Description: Function calls minimum(std::shared_ptr<Node> n).
   Parameters: N/A
   Returns: std::shared_ptr<Node>
 */
 std::shared_ptr<Node> BST::minimum(){
+  if (tombstones > 0) {
+    return liveExtreme(true);
+  }
   if (root != nullptr) {
     return minimum(root);
   }
@@ -83,6 +348,9 @@ std::shared_ptr<Node> BST::minimum(std::shared_ptr<Node> n){
   Returns: std::shared_ptr<Node>
 */
 std::shared_ptr<Node> BST::maximum(){
+  if (tombstones > 0) {
+    return liveExtreme(false);
+  }
   if (root != nullptr) {
     return maximum(root);
   }
@@ -111,21 +379,39 @@ void BST::insertValue(int val){
 }
 
 /*Description: Function inserts value as node into BST. Function
-  does not add repeat values. Function returns shared pointer to
-  inserted node.
+  does not add repeat values; in multiset mode it increments the count
+  of the existing node and returns it. Function returns shared pointer
+  to inserted node.
   Parameters: std::shared_ptr<Node> n, int val
   Returns: std::shared_ptr<Node>
 */
 std::shared_ptr<Node> BST::insertValue(std::shared_ptr<Node> n, int val){
   if (n == nullptr) {
     root = std::shared_ptr<Node>(new Node(val));
+    BST_STAT(allocations);
     size = size + 1;
     return root;
-  } else if (n->value == val) {
+  }
+
+  BST_STAT(nodesVisited);
+  BST_STAT_ADD(comparisons, (n->value == val) ? 1 : 2);
+  if (n->value == val) {
+      if (n->count == 0) {
+        n->count = 1;
+        tombstones = tombstones - 1;
+        size = size + 1;
+        return n;
+      }
+      if (multiset) {
+        n->count = n->count + 1;
+        size = size + 1;
+        return n;
+      }
       return nullptr;
     } else if (n->value < val) {
         if (n->right == nullptr) {
           n->right = std::shared_ptr<Node>(new Node(val));
+          BST_STAT(allocations);
           size = size + 1;
           return n->right;
         } else {
@@ -134,6 +420,7 @@ std::shared_ptr<Node> BST::insertValue(std::shared_ptr<Node> n, int val){
       } else {
           if (n->left == nullptr) {
             n->left = std::shared_ptr<Node>(new Node(val));
+            BST_STAT(allocations);
             size = size + 1;
             return n->left;
           } else {
@@ -142,12 +429,35 @@ std::shared_ptr<Node> BST::insertValue(std::shared_ptr<Node> n, int val){
         }
 }
 
-/*Description: Function calls deleteValue(std::shared_ptr<Node> n, int val).
+/*Description: Function removes one copy of val. A node holding more than
+  one copy only has its count decremented. Otherwise, in lazy delete mode
+  the node becomes a tombstone, and else deleteValue(std::shared_ptr<Node>
+  n, int val) is called to unlink it. Updates size when val is present.
   Parameters: int val
   Returns: void
 */
 void BST::deleteValue(int val){
-  deleteValue(root, val);  
+  Node* n = root.get();
+  while (n != nullptr && n->value != val) {
+    n = (n->value < val) ? n->right.get() : n->left.get();
+  }
+  if (n == nullptr || n->count == 0) {
+    return;
+  }
+
+  if (n->count > 1) {
+    n->count = n->count - 1;
+  } else if (lazyDelete) {
+    n->count = 0;
+    tombstones = tombstones + 1;
+  } else {
+    deleteValue(root, val);
+  }
+  size = size - 1;
+
+  if (tombstones > rebuildThreshold * (size + tombstones)) {
+    rebuild();
+  }
 }
 
 /*Description: Function returns pointer to node with minimum value of
@@ -186,12 +496,19 @@ std::shared_ptr<Node> deleteValueHelperLeft(std::shared_ptr<Node> n) {
   return deleteValueHelperLeft(n->left);
 }
 
-/*Description: Function deletes node in BST and updates size of BST.
+/*Description: Function unlinks the node holding val from the BST,
+  whatever its count. Private: size, copies and tombstones are handled by
+  deleteValue(int val), which only calls this for a last live copy.
   Parameters: std::shared_ptr<Node> n, int val
   Returns: std::shared_ptr<Node>
 */
 std::shared_ptr<Node> BST::deleteValue(std::shared_ptr<Node> n, int val){
   // Deletes root and makes adjustments to tree as necessary.
+  if (n != nullptr) {
+    BST_STAT(nodesVisited);
+    BST_STAT_ADD(comparisons, (n->value == val) ? 1 : 2);
+  }
+
   if (n == nullptr) {
     return nullptr;
   } else if (root->value == val) {
@@ -212,6 +529,7 @@ std::shared_ptr<Node> BST::deleteValue(std::shared_ptr<Node> n, int val){
             // Node to delete has two children. 
               std::shared_ptr<Node> minimumInRightTree = deleteValueMinimum(root->right);    
               root->value = minimumInRightTree->value;
+              root->count = minimumInRightTree->count;
               minimumInRightTree = nullptr;
                 if (root->right->left == nullptr && root->right->right ==nullptr) {
                   root->right = nullptr;
@@ -252,6 +570,7 @@ std::shared_ptr<Node> BST::deleteValue(std::shared_ptr<Node> n, int val){
                   // Node to delete has two children. 
                   std::shared_ptr<Node> minimumInRightTree = deleteValueMinimum(n->left->right);    
                   n->left->value = minimumInRightTree->value;
+                  n->left->count = minimumInRightTree->count;
                   minimumInRightTree = nullptr;
                   if (n->left->right->left == nullptr && n->left->right->right == nullptr) {
                     n->left->right = nullptr;
@@ -294,6 +613,7 @@ std::shared_ptr<Node> BST::deleteValue(std::shared_ptr<Node> n, int val){
                   // Node to delete has two children. 
                     std::shared_ptr<Node> minimumInRightTree = deleteValueMinimum(n->right->right);    
                     n->right->value = minimumInRightTree->value;
+                    n->right->count = minimumInRightTree->count;
                     minimumInRightTree = nullptr;
                     if (n->right->right->left == nullptr && n->right->right->right == nullptr) {
                       n->right->right = nullptr;
@@ -319,6 +639,104 @@ std::shared_ptr<Node> BST::deleteValue(std::shared_ptr<Node> n, int val){
   return nullptr; 
 }
 
+/*Description: Function splits subtree n into l, holding the values less
+  than key (or equal to it when keyGoesLeft), and r, holding the rest.
+  Only the nodes on the search path for key are relinked; the subtrees
+  hanging off that path move whole. Iterative, so degenerate trees do not
+  overflow the call stack.
+  Parameters: std::shared_ptr<Node> n, int key, bool keyGoesLeft,
+  std::shared_ptr<Node> &l, std::shared_ptr<Node> &r
+  Returns: void
+*/
+static void splitAt(std::shared_ptr<Node> n, int key, bool keyGoesLeft, std::shared_ptr<Node> &l, std::shared_ptr<Node> &r){
+  std::shared_ptr<Node>* leftSlot = &l;  // where the next node bound for l goes
+  std::shared_ptr<Node>* rightSlot = &r; // where the next node bound for r goes
+  while (n != nullptr) {
+    if (n->value < key || (keyGoesLeft && n->value == key)) {
+      *leftSlot = n;
+      leftSlot = &n->right;
+      n = n->right;
+    } else {
+      *rightSlot = n;
+      rightSlot = &n->left;
+      n = n->left;
+    }
+  }
+  *leftSlot = nullptr;
+  *rightSlot = nullptr;
+}
+
+/*Description: Function removes every value v with lo <= v <= hi and
+  returns how many were removed, counting every copy. The tree is split
+  along the search paths for lo and hi and the outer parts are joined
+  along the right spine of the lower part, so the cost is O(h) plus the
+  k nodes removed rather than k separate deletes. The detached nodes are
+  freed from an explicit stack after the tree is whole again, each one
+  with its links already cleared, so no destructor recurses.
+  Parameters: int lo, int hi
+  Returns: int
+*/
+int BST::eraseRange(int lo, int hi){
+  if (lo > hi) {
+    return 0;
+  }
+
+  std::shared_ptr<Node> below, rest, inRange, above;
+  splitAt(root, lo, false, below, rest);
+  root = nullptr;
+  splitAt(rest, hi, true, inRange, above);
+  rest = nullptr;
+
+  if (below == nullptr) {
+    root = above;
+  } else {
+    Node* last = below.get();
+    while (last->right != nullptr) {
+      last = last->right.get();
+    }
+    last->right = above;
+    root = below;
+  }
+
+  int erased = 0;
+  std::vector<std::shared_ptr<Node>> stack;
+  if (inRange != nullptr) {
+    stack.push_back(std::move(inRange));
+  }
+  while (!stack.empty()) {
+    std::shared_ptr<Node> n = std::move(stack.back());
+    stack.pop_back();
+    erased = erased + n->count;
+    if (n->count == 0) {
+      tombstones = tombstones - 1;
+    }
+    if (n->left != nullptr) {
+      stack.push_back(std::move(n->left));
+    }
+    if (n->right != nullptr) {
+      stack.push_back(std::move(n->right));
+    }
+  }
+  size = size - erased;
+
+  if (tombstones > rebuildThreshold * (size + tombstones)) {
+    rebuild();
+  }
+  return erased;
+}
+
+/*Description: Function removes every value less than x and returns how
+  many were removed, counting every copy. See eraseRange.
+  Parameters: int x
+  Returns: int
+*/
+int BST::eraseBelow(int x){
+  if (x == INT_MIN) {
+    return 0;
+  }
+  return eraseRange(INT_MIN, x - 1);
+}
+
 /*Description: Function calls isBST(std::shared_ptr<Node> n, 
   int low, int high). Function returns true if BST is a BST
   else returns false.
@@ -347,6 +765,172 @@ bool BST::isBST(std::shared_ptr<Node> n, int low, int high){
   return isBST(n->left,low,n->value) && isBST(n->right,n->value,high);
 }
 
+// Saved trees start with this tag followed by the number of values as a
+// 64 bit integer, then the values in preorder as native ints.
+static const char savedPreorderTag[8] = {'B', 'S', 'T', 'P', 'R', 'E', '0', '1'};
+
+/*Description: Function writes the values of BST to the file at path in
+  preorder, 4 bytes per value. A preorder sequence determines the shape
+  of a BST, so no shape bits are needed. Tombstones are skipped; what is
+  left is still a valid preorder sequence, of the tree with the
+  tombstones spliced out. The walk uses an explicit stack
+  so degenerate trees do not overflow the call stack.
+  Parameters: const std::string &path
+  Returns: bool - false if the file could not be written
+*/
+bool BST::save(const std::string &path){
+  std::vector<int> values;
+  std::vector<Node*> stack;
+  if (root != nullptr) {
+    stack.push_back(root.get());
+  }
+  while (!stack.empty()) {
+    Node* n = stack.back();
+    stack.pop_back();
+    if (n->count > 0) {
+      values.push_back(n->value);
+    }
+    if (n->right != nullptr) {
+      stack.push_back(n->right.get());
+    }
+    if (n->left != nullptr) {
+      stack.push_back(n->left.get());
+    }
+  }
+
+  std::ofstream out(path.c_str(), std::ios::binary | std::ios::trunc);
+  uint64_t count = values.size();
+  out.write(savedPreorderTag, sizeof(savedPreorderTag));
+  out.write(reinterpret_cast<const char*>(&count), sizeof(count));
+  out.write(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(int));
+  out.close();
+  return !out.fail();
+}
+
+/*Description: Function replaces T with the tree saved at path, with the
+  same shape it had when saved. Each value becomes the right child of the
+  largest open node smaller than it, or else the left child of the most
+  recent open node, so the rebuild is O(n) with no searches. T is left
+  unchanged if the file is missing, its length does not match the count
+  in its header, or it is not a valid preorder sequence.
+  Parameters: const std::string &path, BST &T
+  Returns: bool - true if T was loaded
+*/
+bool BST::load(const std::string &path, BST &T){
+  std::ifstream in(path.c_str(), std::ios::binary);
+  char tag[sizeof(savedPreorderTag)];
+  uint64_t count = 0;
+  in.read(tag, sizeof(tag));
+  in.read(reinterpret_cast<char*>(&count), sizeof(count));
+  if (!in || std::memcmp(tag, savedPreorderTag, sizeof(tag)) != 0 || count > INT_MAX) {
+    return false;
+  }
+
+  // Only trust count once the file is known to hold exactly that many
+  // values, so a corrupt header cannot force a huge allocation.
+  if (bytesRemaining(in) != (int64_t)(count * sizeof(int))) {
+    return false;
+  }
+
+  std::vector<int> values(count);
+  in.read(reinterpret_cast<char*>(values.data()), count * sizeof(int));
+  if (!in) {
+    return false;
+  }
+
+  std::shared_ptr<Node> newRoot;
+  // open holds the nodes that may still receive a right child, values
+  // decreasing from bottom to top
+  std::vector<Node*> open;
+  long long lowerBound = (long long)INT_MIN - 1;
+  for (size_t i = 0; i < values.size(); i++) {
+    int v = values[i];
+    if (v <= lowerBound) {
+      return false;
+    }
+    std::shared_ptr<Node> n = std::make_shared<Node>(v);
+
+    Node* parent = nullptr;
+    while (!open.empty() && open.back()->value < v) {
+      parent = open.back();
+      open.pop_back();
+    }
+    if (!open.empty() && open.back()->value == v) {
+      return false;
+    }
+
+    if (parent != nullptr) {
+      // everything after v lies in parent's right subtree
+      lowerBound = parent->value;
+      parent->right = n;
+    } else if (!open.empty()) {
+      open.back()->left = n;
+    } else {
+      newRoot = n;
+    }
+    open.push_back(n.get());
+  }
+
+  T.root = newRoot;
+  T.size = values.size();
+  T.tombstones = 0;
+  return true;
+}
+
+/*Description: Function returns the counters gathered since construction
+  or the last resetStats() together with the current shape of the tree:
+  height, maximum and average depth of its leaves, and bytes held by its
+  nodes. Byte counts exclude allocator and reference count overhead. The
+  walk uses an explicit stack so degenerate trees do not overflow the
+  call stack.
+  Parameters: N/A
+  Returns: BSTStats
+*/
+BSTStats BST::treeStats(){
+  BSTStats stats = counters;
+  stats.maxLeafDepth = -1;
+  stats.averageLeafDepth = 0;
+
+  long long nodes = 0;
+  long long leaves = 0;
+  long long leafDepthSum = 0;
+  std::vector<std::pair<Node*, int>> stack;
+  if (root != nullptr) {
+    stack.push_back(std::make_pair(root.get(), 0));
+  }
+  while (!stack.empty()) {
+    Node* n = stack.back().first;
+    int depth = stack.back().second;
+    stack.pop_back();
+    nodes = nodes + 1;
+    if (n->left == nullptr && n->right == nullptr) {
+      leaves = leaves + 1;
+      leafDepthSum = leafDepthSum + depth;
+      stats.maxLeafDepth = std::max(stats.maxLeafDepth, depth);
+    }
+    if (n->left != nullptr) {
+      stack.push_back(std::make_pair(n->left.get(), depth + 1));
+    }
+    if (n->right != nullptr) {
+      stack.push_back(std::make_pair(n->right.get(), depth + 1));
+    }
+  }
+  if (leaves > 0) {
+    stats.averageLeafDepth = (double)leafDepthSum / leaves;
+  }
+  stats.height = stats.maxLeafDepth;
+  stats.bytes = nodes * sizeof(Node);
+  return stats;
+}
+
+/*Description: Function sets all counters reported by treeStats() to zero.
+  Parameters: N/A
+  Returns: void
+*/
+void BST::resetStats(){
+  counters = BSTStats();
+}
+
 /*Description: Function outputs preorder traversal of given BST to console.
   Parameters: std::shared_ptr<Node> n, 
   std::vector<std::shared_ptr<Node>> &order
@@ -354,7 +938,9 @@ bool BST::isBST(std::shared_ptr<Node> n, int low, int high){
 */
 void BST::preOrder(std::shared_ptr<Node> n, std::vector<std::shared_ptr<Node>> &order){
   if (n != nullptr) {
-    cout << n->value << " ";
+    if (n->count > 0) {
+      cout << n->value << " ";
+    }
     preOrder(n->left,order);
     preOrder(n->right,order);
   }
@@ -368,7 +954,9 @@ void BST::preOrder(std::shared_ptr<Node> n, std::vector<std::shared_ptr<Node>> &
 void BST::inOrder(std::shared_ptr<Node> n, std::vector<std::shared_ptr<Node>> &order){
   if (n != nullptr) {
     inOrder(n->left, order);
-    order.push_back(n);
+    if (n->count > 0) {
+      order.push_back(n);
+    }
     inOrder(n->right, order);
   }
 }
@@ -382,6 +970,8 @@ void BST::postOrder(std::shared_ptr<Node> n, std::vector<std::shared_ptr<Node>>
   if (n != nullptr) {
     postOrder(n->left, order);
     postOrder(n->right, order);
-    order.push_back(n);
+    if (n->count > 0) {
+      order.push_back(n);
+    }
   }
 }
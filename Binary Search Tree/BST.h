@@ -6,9 +6,23 @@
 #define BST_H
 
 #include <memory>
+#include <string>
 #include <vector>
 #include "Node.h"
 
+// Counters are only updated when built with -DTREE_STATS and stay zero
+// otherwise. The shape fields are filled in by treeStats() in any build.
+struct BSTStats{
+  long long searches;
+  long long comparisons;
+  long long nodesVisited;
+  long long allocations;
+  int height;
+  int maxLeafDepth;
+  double averageLeafDepth;
+  long long bytes;
+};
+
 class BST{
   public:
     std::shared_ptr<Node> root;
@@ -17,8 +31,17 @@ class BST{
     BST();
     ~BST();
 
+    void setMultiset(bool);
+    void setLazyDelete(bool);
+    void setRebuildThreshold(double);
+    int getTombstones();
+    void rebuild();
+    int count(int);
+    int countInRange(int, int);
+
     std::shared_ptr<Node> search(int);
     std::shared_ptr<Node> search(std::shared_ptr<Node>, int);
+    void searchBatch(const std::vector<int>&, std::vector<std::shared_ptr<Node>>&, int);
 
     std::shared_ptr<Node> minimum();
     std::shared_ptr<Node> minimum(std::shared_ptr<Node>);
@@ -28,14 +51,35 @@ class BST{
     void insertValue(int);
     std::shared_ptr<Node> insertValue(std::shared_ptr<Node>, int);
     void deleteValue(int);
-    std::shared_ptr<Node> deleteValue(std::shared_ptr<Node>, int);
+    int eraseRange(int, int);
+    int eraseBelow(int);
 
     bool isBST(std::shared_ptr<Node>);
     bool isBST(std::shared_ptr<Node>, int, int);
+
+    bool save(const std::string&);
+    static bool load(const std::string&, BST&);
+
+    BSTStats treeStats();
+    void resetStats();
   
     void preOrder(std::shared_ptr<Node>, std::vector<std::shared_ptr<Node>>&);
     void inOrder(std::shared_ptr<Node>, std::vector<std::shared_ptr<Node>>&);
     void postOrder(std::shared_ptr<Node>, std::vector<std::shared_ptr<Node>>&);
+
+  private:
+    BSTStats counters;
+    bool multiset;
+    bool lazyDelete;
+    int tombstones;          // nodes left in place by lazy deletes, count 0
+    double rebuildThreshold; // tombstone fraction that triggers rebuild()
+
+    std::shared_ptr<Node> liveExtreme(bool);
+    // Unlinks the node holding val; deleteValue(int) keeps size, copies
+    // and tombstones in step, so it is the only caller
+    std::shared_ptr<Node> deleteValue(std::shared_ptr<Node>, int);
+
+    static const int maxSearchGroup = 32;
 };
 
 #endif
\ No newline at end of file
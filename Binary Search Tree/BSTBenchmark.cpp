@@ -0,0 +1,111 @@
+// File: BSTBenchmark.cpp
+// Description: Measures lookup throughput of SplayTree, BST and AVLTree
+// when keys are requested with Zipf skew s from 0.5 to 1.2. The key of
+// popularity rank r is drawn with probability proportional to 1 / r^s,
+// and ranks are mapped to keys at random so hot keys are spread over the
+// key space. SplayTreeFull splays on every search, SplayTree uses the
+// default splay depth; each run starts from a freshly built tree. Prints
+// one CSV line per structure and skew:
+//   structure,skew,n,seconds,ops_per_second
+// Usage: ./BSTBenchmark [n] [lookups]
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+#include "BST.h"
+#include "SplayTree.h"
+#include "AVLTree.h"
+using namespace std;
+
+typedef chrono::steady_clock Clock;
+
+vector<int> zipfKeys(const vector<int> &keysByRank, double skew, int count, mt19937 &gen);
+void report(const char* structure, double skew, int n, int ops, double seconds);
+
+int main(int argc, char** argv){
+  int n = (argc > 1) ? atoi(argv[1]) : 1000000;
+  int lookups = (argc > 2) ? atoi(argv[2]) : 2000000;
+  double skews[] = {0.5, 0.7, 0.9, 1.0, 1.1, 1.2};
+
+  mt19937 gen(39);
+  vector<int> keys(n);
+  for (int i = 0; i < n; i++){
+    keys[i] = i;
+  }
+  shuffle(keys.begin(), keys.end(), gen);
+
+  BST bst;
+  AVLTree avl;
+  for (int i = 0; i < n; i++){
+    bst.insertValue(keys[i]);
+    avl.insertValue(keys[i]);
+  }
+
+  long checksum = 0;
+  Clock::time_point start;
+  for (int s = 0; s < 6; s++){
+    vector<int> requests = zipfKeys(keys, skews[s], lookups, gen);
+
+    for (int mode = 0; mode < 2; mode++){
+      SplayTree splay;
+      splay.setSplayDepth(mode == 0 ? 0 : 12);
+      for (int i = 0; i < n; i++){ splay.insertValue(keys[i]); }
+      start = Clock::now();
+      for (int i = 0; i < lookups; i++){ checksum += (splay.search(requests[i]) != nullptr); }
+      report(mode == 0 ? "SplayTreeFull" : "SplayTree", skews[s], n, lookups,
+             chrono::duration<double>(Clock::now() - start).count());
+    }
+
+    start = Clock::now();
+    for (int i = 0; i < lookups; i++){ checksum += (bst.search(requests[i]) != nullptr); }
+    report("BST", skews[s], n, lookups, chrono::duration<double>(Clock::now() - start).count());
+
+    start = Clock::now();
+    for (int i = 0; i < lookups; i++){ checksum += (avl.search(requests[i]) != nullptr); }
+    report("AVLTree", skews[s], n, lookups, chrono::duration<double>(Clock::now() - start).count());
+  }
+
+  cerr << "checksum " << checksum << endl;
+  return 0;
+}
+
+/****************************************************************************
+ * Draw count keys with Zipf skew. keysByRank[r] is the key of rank r + 1   *
+ * keysByRank - const vector<int> & - keys ordered by popularity            *
+ * skew - double - Zipf exponent s                                          *
+ * count - int - number of keys to draw                                     *
+ * gen - mt19937 & - random source                                          *
+ * *************************************************************************/
+vector<int> zipfKeys(const vector<int> &keysByRank, double skew, int count, mt19937 &gen){
+  int n = keysByRank.size();
+  vector<double> cumulative(n);
+  double total = 0;
+  for (int r = 0; r < n; r++){
+    total += 1.0 / pow(r + 1.0, skew);
+    cumulative[r] = total;
+  }
+
+  uniform_real_distribution<double> pick(0.0, total);
+  vector<int> requests(count);
+  for (int i = 0; i < count; i++){
+    int r = upper_bound(cumulative.begin(), cumulative.end(), pick(gen)) - cumulative.begin();
+    requests[i] = keysByRank[min(r, n - 1)];
+  }
+  return requests;
+}
+
+/****************************************************************
+ * Print one CSV result line                                    *
+ * structure - const char* - name of the tree measured          *
+ * skew - double - Zipf exponent of the lookups                 *
+ * n - int - number of keys in the tree                         *
+ * ops - int - number of lookups timed                          *
+ * seconds - double - time taken by all lookups                 *
+ * *************************************************************/
+void report(const char* structure, double skew, int n, int ops, double seconds){
+  cout << structure << "," << skew << "," << n << "," << seconds << "," << (ops / seconds) << endl;
+}
@@ -12,6 +12,7 @@ void printVector(const vector<std::shared_ptr<Node>> &v);
 void runSearch(std::shared_ptr<BST> T);
 void runInsert(std::shared_ptr<BST> T);
 void runDelete(std::shared_ptr<BST> T);
+void printStats(const BSTStats &stats);
 
 /**************************************************
  * Simple main to test Binary Search Tree methods *
@@ -64,6 +65,10 @@ int main(){
         cout << "IS BST" << endl;
         cout << T->isBST(T->root) << endl;
         break;
+      case 14: // tree statistics
+        cout << "STATS" << endl;
+        printStats(T->treeStats());
+        break;
       default:
         break;
     }
@@ -117,4 +122,20 @@ void runDelete(std::shared_ptr<BST> T){
   cin >> remove;
   cout << remove << endl;
   T->deleteValue(remove);
+}
+
+/*************************************************************************
+ * Print counters and shape of a tree, one "name value" pair per line.   *
+ * Counters are zero unless the driver was built with -DTREE_STATS       *
+ * stats - const BSTStats & - result of BST::treeStats                   *
+ * ***********************************************************************/
+void printStats(const BSTStats &stats){
+  cout << "searches " << stats.searches << endl;
+  cout << "comparisons " << stats.comparisons << endl;
+  cout << "nodesVisited " << stats.nodesVisited << endl;
+  cout << "allocations " << stats.allocations << endl;
+  cout << "height " << stats.height << endl;
+  cout << "maxLeafDepth " << stats.maxLeafDepth << endl;
+  cout << "averageLeafDepth " << stats.averageLeafDepth << endl;
+  cout << "bytes " << stats.bytes << endl;
 }
\ No newline at end of file
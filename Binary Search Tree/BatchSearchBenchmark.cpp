@@ -0,0 +1,102 @@
+// File: BatchSearchBenchmark.cpp
+// Description: Measures lookup throughput of BST and AVLTree when lookups
+// are run one at a time with search and when they are interleaved in
+// groups of 1 to 32 with searchBatch. Trees are built by inserting keys
+// 0..n-1 in random order, so nodes are scattered over the heap the way
+// they are in a long lived tree. Pick n so the trees are several times
+// larger than the last level cache; at the default of 8M keys each tree
+// takes roughly half a gigabyte. Lookups are random keys present in the
+// tree. Prints one CSV line per structure and method:
+//   structure,method,group,n,seconds,ops_per_second
+// Usage: ./BatchSearchBenchmark [n] [lookups]
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+#include "BST.h"
+#include "AVLTree.h"
+using namespace std;
+
+typedef chrono::steady_clock Clock;
+
+template <class Tree, class NodePointer>
+void runGroups(const char* structure, Tree &tree, const vector<int> &queries, int n, long &checksum);
+void report(const char* structure, const char* method, int group, int n, int ops, double seconds);
+
+int main(int argc, char** argv){
+  int n = (argc > 1) ? atoi(argv[1]) : 8000000;
+  int lookups = (argc > 2) ? atoi(argv[2]) : 4000000;
+
+  mt19937 gen(47);
+  vector<int> keys(n);
+  for (int i = 0; i < n; i++){
+    keys[i] = i;
+  }
+  shuffle(keys.begin(), keys.end(), gen);
+
+  vector<int> queries(lookups);
+  for (int i = 0; i < lookups; i++){
+    queries[i] = gen() % n;
+  }
+
+  long checksum = 0;
+  {
+    BST tree;
+    for (int i = 0; i < n; i++){ tree.insertValue(keys[i]); }
+    runGroups<BST, shared_ptr<Node>>("BST", tree, queries, n, checksum);
+  }
+  {
+    AVLTree tree;
+    for (int i = 0; i < n; i++){ tree.insertValue(keys[i]); }
+    runGroups<AVLTree, shared_ptr<AVLNode>>("AVLTree", tree, queries, n, checksum);
+  }
+
+  cerr << "checksum " << checksum << endl;
+  return 0;
+}
+
+/****************************************************************
+ * Time the queries with search, then with searchBatch for each *
+ * group size from 1 to 32                                      *
+ * structure - const char* - name of the tree measured          *
+ * tree - Tree & - tree holding keys 0..n-1                     *
+ * queries - const vector<int> & - keys to look up              *
+ * n - int - number of keys in the tree                         *
+ * checksum - long & - accumulates results so work is not       *
+ *   optimized away                                             *
+ * *************************************************************/
+template <class Tree, class NodePointer>
+void runGroups(const char* structure, Tree &tree, const vector<int> &queries, int n, long &checksum){
+  int lookups = queries.size();
+  Clock::time_point start = Clock::now();
+  for (int i = 0; i < lookups; i++){
+    checksum += (tree.search(queries[i]) != nullptr);
+  }
+  report(structure, "search", 1, n, lookups, chrono::duration<double>(Clock::now() - start).count());
+
+  vector<NodePointer> results;
+  for (int group = 1; group <= 32; group *= 2){
+    start = Clock::now();
+    tree.searchBatch(queries, results, group);
+    for (int i = 0; i < lookups; i++){
+      checksum += (results[i] != nullptr);
+    }
+    report(structure, "searchBatch", group, n, lookups, chrono::duration<double>(Clock::now() - start).count());
+  }
+}
+
+/****************************************************************
+ * Print one CSV result line                                    *
+ * structure - const char* - name of the tree measured          *
+ * method - const char* - lookup method timed                   *
+ * group - int - lookups in flight at once                      *
+ * n - int - number of keys in the tree                         *
+ * ops - int - number of lookups timed                          *
+ * seconds - double - time taken by all lookups                 *
+ * *************************************************************/
+void report(const char* structure, const char* method, int group, int n, int ops, double seconds){
+  cout << structure << "," << method << "," << group << "," << n << "," << seconds << "," << (ops / seconds) << endl;
+}
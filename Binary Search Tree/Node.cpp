@@ -6,12 +6,14 @@
 
 Node::Node(){
   value = 0;
+  count = 1;
   left = nullptr;
   right = nullptr;
 }
 
 Node::Node(int v){
   value = v;
+  count = 1;
   left = nullptr;
   right = nullptr;
 }
@@ -10,6 +10,7 @@
 class Node{
   public:
     int value;
+    int count; // copies of value held, above 1 only in multiset mode
     std::shared_ptr<Node> left;
     std::shared_ptr<Node> right;
     
@@ -0,0 +1,254 @@
+// File: SplayTree.cpp
+// Description: File contains the top-down splay operation and the search,
+// insert and delete functions built on it.
+
+#include <limits.h>
+#include <utility>
+#include "SplayTree.h"
+
+// Constructor for SplayTree
+SplayTree::SplayTree(){
+  root = nullptr;
+  size = 0;
+  splayDepth = 12;
+}
+
+// Destructor for SplayTree. Nodes are unlinked one at a time because a
+// splay tree may be a single long path (e.g. after inserting sorted
+// values) and recursive shared_ptr destruction would overflow the stack.
+SplayTree::~SplayTree(){
+  std::vector<std::shared_ptr<Node>> stack;
+  if (root != nullptr) {
+    stack.push_back(root);
+  }
+  root = nullptr;
+  while (!stack.empty()) {
+    std::shared_ptr<Node> n = stack.back();
+    stack.pop_back();
+    if (n->left != nullptr) {
+      stack.push_back(n->left);
+    }
+    if (n->right != nullptr) {
+      stack.push_back(n->right);
+    }
+    n->left = nullptr;
+    n->right = nullptr;
+  }
+}
+
+/*Description: Function returns pointer to node with value matching
+  target, else nullptr. A target found within splayDepth steps of the
+  root is returned without restructuring; otherwise target (or the last
+  node on its search path) is splayed to the root. Skipping splays on
+  short paths keeps hot keys from dirtying the top of the tree on every
+  access and does not change the amortized bound, since those lookups
+  already cost O(1).
+  Parameters: int target
+  Returns: std::shared_ptr<Node>
+*/
+std::shared_ptr<Node> SplayTree::search(int target){
+  const std::shared_ptr<Node>* slot = &root;
+  int depth = 0;
+  while (*slot != nullptr && (*slot)->value != target && depth < splayDepth) {
+    slot = ((*slot)->value < target) ? &(*slot)->right : &(*slot)->left;
+    depth = depth + 1;
+  }
+  if (*slot != nullptr && (*slot)->value == target) {
+    return *slot;
+  }
+  splay(target);
+  if (root != nullptr && root->value == target) {
+    return root;
+  }
+  return nullptr;
+}
+
+/*Description: Function sets how deep a search may find its target
+  without splaying it. 0 splays on every search.
+  Parameters: int depth
+  Returns: void
+*/
+void SplayTree::setSplayDepth(int depth){
+  splayDepth = depth;
+}
+
+/*Description: Function splays the minimum value to the root and returns
+  it.
+  Parameters: N/A
+  Returns: std::shared_ptr<Node>
+*/
+std::shared_ptr<Node> SplayTree::minimum(){
+  splay(INT_MIN);
+  return root;
+}
+
+/*Description: Function splays the maximum value to the root and returns
+  it.
+  Parameters: N/A
+  Returns: std::shared_ptr<Node>
+*/
+std::shared_ptr<Node> SplayTree::maximum(){
+  splay(INT_MAX);
+  return root;
+}
+
+/*Description: Function inserts val as the new root. After splaying val's
+  neighbour to the root, the old root and one of its subtrees become the
+  children of the new node. Function does not add repeat values.
+  Parameters: int val
+  Returns: void
+*/
+void SplayTree::insertValue(int val){
+  if (root == nullptr) {
+    root = std::make_shared<Node>(val);
+    size = size + 1;
+    return;
+  }
+
+  splay(val);
+  if (root->value == val) {
+    return;
+  }
+
+  std::shared_ptr<Node> n = std::make_shared<Node>(val);
+  if (val < root->value) {
+    n->left = root->left;
+    n->right = root;
+    root->left = nullptr;
+  } else {
+    n->right = root->right;
+    n->left = root;
+    root->right = nullptr;
+  }
+  root = n;
+  size = size + 1;
+}
+
+/*Description: Function removes val if present. After val is splayed to
+  the root, splaying val again in the left subtree brings its maximum up
+  with an empty right subtree, where the old right subtree is attached.
+  Parameters: int val
+  Returns: void
+*/
+void SplayTree::deleteValue(int val){
+  splay(val);
+  if (root == nullptr || root->value != val) {
+    return;
+  }
+
+  if (root->left == nullptr) {
+    root = root->right;
+  } else {
+    std::shared_ptr<Node> right = root->right;
+    root = root->left;
+    splay(val);
+    root->right = right;
+  }
+  size = size - 1;
+}
+
+/*Description: Function passes nodes to a vector in preorder.
+  Parameters: std::shared_ptr<Node> n,
+  std::vector<std::shared_ptr<Node>> &order
+  Returns: void
+*/
+void SplayTree::preOrder(std::shared_ptr<Node> n, std::vector<std::shared_ptr<Node>> &order){
+  if (n != nullptr) {
+    order.push_back(n);
+    preOrder(n->left, order);
+    preOrder(n->right, order);
+  }
+}
+
+/*Description: Function passes nodes to a vector in ascending order.
+  Parameters: std::shared_ptr<Node> n,
+  std::vector<std::shared_ptr<Node>> &order
+  Returns: void
+*/
+void SplayTree::inOrder(std::shared_ptr<Node> n, std::vector<std::shared_ptr<Node>> &order){
+  if (n != nullptr) {
+    inOrder(n->left, order);
+    order.push_back(n);
+    inOrder(n->right, order);
+  }
+}
+
+/*Description: Function passes nodes to a vector in post order.
+  Parameters: std::shared_ptr<Node> n,
+  std::vector<std::shared_ptr<Node>> &order
+  Returns: void
+*/
+void SplayTree::postOrder(std::shared_ptr<Node> n, std::vector<std::shared_ptr<Node>> &order){
+  if (n != nullptr) {
+    postOrder(n->left, order);
+    postOrder(n->right, order);
+    order.push_back(n);
+  }
+}
+
+/*Description: Top-down splay. Walks down from the root toward val,
+  rotating on zig-zig steps and hanging passed nodes off the bottom of a
+  left tree (values < val) and a right tree (values > val). The last node
+  reached becomes the root with the left and right trees as its children.
+  Parameters: int val
+  Returns: void
+*/
+void SplayTree::splay(int val){
+  if (root == nullptr) {
+    return;
+  }
+
+  // header.right collects the left tree and header.left the right tree.
+  // Links are moved rather than copied so the walk does no reference
+  // count updates.
+  Node header;
+  Node* leftMax = &header;
+  Node* rightMin = &header;
+  std::shared_ptr<Node> t = std::move(root);
+
+  while (true) {
+    if (val < t->value) {
+      if (t->left == nullptr) {
+        break;
+      }
+      if (val < t->left->value) {
+        std::shared_ptr<Node> temp = std::move(t->left); // rotate right
+        t->left = std::move(temp->right);
+        temp->right = std::move(t);
+        t = std::move(temp);
+        if (t->left == nullptr) {
+          break;
+        }
+      }
+      std::shared_ptr<Node> next = std::move(t->left); // link right
+      rightMin->left = std::move(t);
+      rightMin = rightMin->left.get();
+      t = std::move(next);
+    } else if (val > t->value) {
+      if (t->right == nullptr) {
+        break;
+      }
+      if (val > t->right->value) {
+        std::shared_ptr<Node> temp = std::move(t->right); // rotate left
+        t->right = std::move(temp->left);
+        temp->left = std::move(t);
+        t = std::move(temp);
+        if (t->right == nullptr) {
+          break;
+        }
+      }
+      std::shared_ptr<Node> next = std::move(t->right); // link left
+      leftMax->right = std::move(t);
+      leftMax = leftMax->right.get();
+      t = std::move(next);
+    } else {
+      break;
+    }
+  }
+
+  leftMax->right = std::move(t->left);
+  rightMin->left = std::move(t->right);
+  t->left = std::move(header.right);
+  t->right = std::move(header.left);
+  root = std::move(t);
+}
@@ -0,0 +1,44 @@
+// File: SplayTree.h
+// Description: Self-adjusting binary search tree built from the same Node
+// as BST. Every search, insert and delete splays the accessed key to the
+// root top-down, so frequently used keys stay within a few steps of the
+// root and any sequence of m operations costs O(m log n) amortized.
+
+#ifndef SPLAYTREE_H
+#define SPLAYTREE_H
+
+#include <memory>
+#include <vector>
+#include "Node.h"
+
+class SplayTree{
+  public:
+    std::shared_ptr<Node> root;
+    int size;
+
+    SplayTree();
+    ~SplayTree();
+
+    std::shared_ptr<Node> search(int);
+    void setSplayDepth(int);
+
+    std::shared_ptr<Node> minimum();
+    std::shared_ptr<Node> maximum();
+
+    void insertValue(int);
+    void deleteValue(int);
+
+    void preOrder(std::shared_ptr<Node>, std::vector<std::shared_ptr<Node>>&);
+    void inOrder(std::shared_ptr<Node>, std::vector<std::shared_ptr<Node>>&);
+    void postOrder(std::shared_ptr<Node>, std::vector<std::shared_ptr<Node>>&);
+
+  private:
+    int splayDepth;
+
+    SplayTree(const SplayTree&);
+    SplayTree& operator=(const SplayTree&);
+
+    void splay(int);
+};
+
+#endif
@@ -0,0 +1,264 @@
+// File: Treap.cpp
+// Description: File contains split and merge for a treap and the search,
+// insert, delete, range deletion and concatenation built on them. Split
+// and merge walk down iteratively and move links rather than copy them.
+
+#include <limits.h>
+#include <utility>
+#include "Treap.h"
+
+// Constructor for Treap, priorities are seeded from std::random_device
+Treap::Treap() : generator(std::random_device()()){
+  root = nullptr;
+  size = 0;
+}
+
+/*Description: Constructor for Treap whose priorities come from a
+  generator seeded with seed, so the same inserts always give the same
+  shape. Meant for benchmarks and debugging; a fixed seed lets an
+  adversary who knows it pick keys that unbalance the tree.
+  Parameters: unsigned seed
+  Returns: N/A
+*/
+Treap::Treap(unsigned seed) : generator(seed){
+  root = nullptr;
+  size = 0;
+}
+
+/*Description: Function returns pointer to node with value matching
+  target. Else returns nullptr.
+  Parameters: int target
+  Returns: std::shared_ptr<TreapNode>
+*/
+std::shared_ptr<TreapNode> Treap::search(int target){
+  const std::shared_ptr<TreapNode>* slot = &root;
+  TreapNode* n = root.get();
+  while (n != nullptr && n->value != target) {
+    slot = (n->value < target) ? &n->right : &n->left;
+    n = slot->get();
+  }
+  return (n == nullptr) ? nullptr : *slot;
+}
+
+/*Description: Function returns pointer to node holding the minimum value,
+  or nullptr if the treap is empty.
+  Parameters: N/A
+  Returns: std::shared_ptr<TreapNode>
+*/
+std::shared_ptr<TreapNode> Treap::minimum(){
+  if (root == nullptr) {
+    return nullptr;
+  }
+  const std::shared_ptr<TreapNode>* slot = &root;
+  while ((*slot)->left != nullptr) {
+    slot = &(*slot)->left;
+  }
+  return *slot;
+}
+
+/*Description: Function returns pointer to node holding the maximum value,
+  or nullptr if the treap is empty.
+  Parameters: N/A
+  Returns: std::shared_ptr<TreapNode>
+*/
+std::shared_ptr<TreapNode> Treap::maximum(){
+  if (root == nullptr) {
+    return nullptr;
+  }
+  const std::shared_ptr<TreapNode>* slot = &root;
+  while ((*slot)->right != nullptr) {
+    slot = &(*slot)->right;
+  }
+  return *slot;
+}
+
+/*Description: Function inserts val with a random priority. It descends
+  until it reaches the subtree whose root has a lower priority, splits
+  that subtree around val and puts the new node in its place. Function
+  does not add repeat values.
+  Parameters: int val
+  Returns: void
+*/
+void Treap::insertValue(int val){
+  if (search(val) != nullptr) {
+    return;
+  }
+
+  std::shared_ptr<TreapNode> node = std::make_shared<TreapNode>(val, generator());
+  std::shared_ptr<TreapNode>* slot = &root;
+  while (*slot != nullptr && (*slot)->priority >= node->priority) {
+    slot = (val < (*slot)->value) ? &(*slot)->left : &(*slot)->right;
+  }
+  split(std::move(*slot), val, node->left, node->right);
+  *slot = std::move(node);
+  size = size + 1;
+}
+
+/*Description: Function removes val if present by replacing its node with
+  the merge of the node's two subtrees.
+  Parameters: int val
+  Returns: void
+*/
+void Treap::deleteValue(int val){
+  std::shared_ptr<TreapNode>* slot = &root;
+  while (*slot != nullptr && (*slot)->value != val) {
+    slot = ((*slot)->value < val) ? &(*slot)->right : &(*slot)->left;
+  }
+  if (*slot == nullptr) {
+    return;
+  }
+
+  std::shared_ptr<TreapNode> n = std::move(*slot);
+  *slot = merge(std::move(n->left), std::move(n->right));
+  size = size - 1;
+}
+
+/*Description: Function removes every value v with lo <= v <= hi. Two
+  splits cut the range out as one subtree and a merge joins what is left,
+  so apart from freeing the removed nodes this costs O(log n) expected.
+  Parameters: int lo, int hi
+  Returns: int - number of values removed
+*/
+int Treap::eraseRange(int lo, int hi){
+  if (lo > hi) {
+    return 0;
+  }
+
+  std::shared_ptr<TreapNode> less, middle, greater;
+  split(std::move(root), lo, less, middle);
+  if (hi < INT_MAX) {
+    std::shared_ptr<TreapNode> rest;
+    split(std::move(middle), hi + 1, rest, greater);
+    middle = std::move(rest);
+  }
+
+  int removed = countNodes(middle);
+  root = merge(std::move(less), std::move(greater));
+  size = size - removed;
+  return removed;
+}
+
+/*Description: Function moves every value of other into this treap and
+  leaves other empty. When all values of other are greater than all
+  values of this treap the two are merged in O(log n) expected; otherwise
+  the values of other are inserted one at a time.
+  Parameters: Treap &other
+  Returns: void
+*/
+void Treap::concatenate(Treap &other){
+  if (other.root == nullptr) {
+    return;
+  }
+
+  if (root == nullptr || maximum()->value < other.minimum()->value) {
+    root = merge(std::move(root), std::move(other.root));
+    size = size + other.size;
+  } else {
+    std::vector<std::shared_ptr<TreapNode>> order;
+    other.inOrder(other.root, order);
+    for (size_t i = 0; i < order.size(); i++) {
+      insertValue(order[i]->value);
+    }
+  }
+  other.root = nullptr;
+  other.size = 0;
+}
+
+/*Description: Function passes nodes to a vector in preorder.
+  Parameters: std::shared_ptr<TreapNode> n,
+  std::vector<std::shared_ptr<TreapNode>> &order
+  Returns: void
+*/
+void Treap::preOrder(std::shared_ptr<TreapNode> n, std::vector<std::shared_ptr<TreapNode>> &order){
+  if (n != nullptr) {
+    order.push_back(n);
+    preOrder(n->left, order);
+    preOrder(n->right, order);
+  }
+}
+
+/*Description: Function passes nodes to a vector in ascending order.
+  Parameters: std::shared_ptr<TreapNode> n,
+  std::vector<std::shared_ptr<TreapNode>> &order
+  Returns: void
+*/
+void Treap::inOrder(std::shared_ptr<TreapNode> n, std::vector<std::shared_ptr<TreapNode>> &order){
+  if (n != nullptr) {
+    inOrder(n->left, order);
+    order.push_back(n);
+    inOrder(n->right, order);
+  }
+}
+
+/*Description: Function passes nodes to a vector in post order.
+  Parameters: std::shared_ptr<TreapNode> n,
+  std::vector<std::shared_ptr<TreapNode>> &order
+  Returns: void
+*/
+void Treap::postOrder(std::shared_ptr<TreapNode> n, std::vector<std::shared_ptr<TreapNode>> &order){
+  if (n != nullptr) {
+    postOrder(n->left, order);
+    postOrder(n->right, order);
+    order.push_back(n);
+  }
+}
+
+/*Description: Function splits subtree n into l holding the values less
+  than key and r holding the rest. Walks one path from n downward, so
+  costs O(log n) expected. Any previous contents of l and r are replaced.
+  Parameters: std::shared_ptr<TreapNode> n, int key,
+  std::shared_ptr<TreapNode> &l, std::shared_ptr<TreapNode> &r
+  Returns: void
+*/
+void Treap::split(std::shared_ptr<TreapNode> n, int key, std::shared_ptr<TreapNode> &l, std::shared_ptr<TreapNode> &r){
+  std::shared_ptr<TreapNode>* leftSlot = &l;
+  std::shared_ptr<TreapNode>* rightSlot = &r;
+  while (n != nullptr) {
+    if (n->value < key) {
+      std::shared_ptr<TreapNode> next = std::move(n->right);
+      *leftSlot = std::move(n);
+      leftSlot = &(*leftSlot)->right;
+      n = std::move(next);
+    } else {
+      std::shared_ptr<TreapNode> next = std::move(n->left);
+      *rightSlot = std::move(n);
+      rightSlot = &(*rightSlot)->left;
+      n = std::move(next);
+    }
+  }
+  *leftSlot = nullptr;
+  *rightSlot = nullptr;
+}
+
+/*Description: Function merges subtrees l and r, where every value of l is
+  less than every value of r, and returns the root of the result. Walks
+  down the right spine of l and the left spine of r, taking the node with
+  the higher priority at each step.
+  Parameters: std::shared_ptr<TreapNode> l, std::shared_ptr<TreapNode> r
+  Returns: std::shared_ptr<TreapNode>
+*/
+std::shared_ptr<TreapNode> Treap::merge(std::shared_ptr<TreapNode> l, std::shared_ptr<TreapNode> r){
+  std::shared_ptr<TreapNode> result;
+  std::shared_ptr<TreapNode>* slot = &result;
+  while (l != nullptr && r != nullptr) {
+    if (l->priority > r->priority) {
+      *slot = std::move(l);
+      slot = &(*slot)->right;
+      l = std::move(*slot);
+    } else {
+      *slot = std::move(r);
+      slot = &(*slot)->left;
+      r = std::move(*slot);
+    }
+  }
+  *slot = (l != nullptr) ? std::move(l) : std::move(r);
+  return result;
+}
+
+// Returns number of nodes in subtree n.
+int Treap::countNodes(const std::shared_ptr<TreapNode> &n){
+  if (n == nullptr) {
+    return 0;
+  }
+  return countNodes(n->left) + countNodes(n->right) + 1;
+}
@@ -0,0 +1,48 @@
+// File: Treap.h
+// Description: Randomized binary search tree with the same interface as
+// BST. Every update is expressed through split and merge, which run in
+// O(log n) expected time whatever order values are inserted in, so the
+// tree stays balanced without heights or rotations. Split and merge also
+// give range deletion and concatenation of whole trees.
+
+#ifndef TREAP_H
+#define TREAP_H
+
+#include <memory>
+#include <random>
+#include <vector>
+#include "TreapNode.h"
+
+class Treap{
+  public:
+    std::shared_ptr<TreapNode> root;
+    int size;
+
+    Treap();
+    explicit Treap(unsigned);
+
+    std::shared_ptr<TreapNode> search(int);
+
+    std::shared_ptr<TreapNode> minimum();
+    std::shared_ptr<TreapNode> maximum();
+
+    void insertValue(int);
+    void deleteValue(int);
+
+    int eraseRange(int, int);
+    void concatenate(Treap&);
+
+    void preOrder(std::shared_ptr<TreapNode>, std::vector<std::shared_ptr<TreapNode>>&);
+    void inOrder(std::shared_ptr<TreapNode>, std::vector<std::shared_ptr<TreapNode>>&);
+    void postOrder(std::shared_ptr<TreapNode>, std::vector<std::shared_ptr<TreapNode>>&);
+
+    static void split(std::shared_ptr<TreapNode>, int, std::shared_ptr<TreapNode>&, std::shared_ptr<TreapNode>&);
+    static std::shared_ptr<TreapNode> merge(std::shared_ptr<TreapNode>, std::shared_ptr<TreapNode>);
+
+  private:
+    std::mt19937 generator;
+
+    static int countNodes(const std::shared_ptr<TreapNode>&);
+};
+
+#endif
@@ -0,0 +1,124 @@
+// File: TreapBenchmark.cpp
+// Description: Compares Treap with BST when keys are inserted in random
+// and in sorted order. For each order both trees insert n keys, look each
+// of them up, and remove the middle half of the key range; BST removes
+// the keys one at a time while Treap uses a single eraseRange. Treap also
+// times concatenating two trees of n / 2 keys. Sorted runs use a smaller
+// n by default because BST degenerates to a list on sorted input and its
+// operations become linear. Treaps use fixed seeds, so every run builds
+// the same shapes. Prints one CSV line per measurement:
+//   structure,operation,order,n,seconds,ops_per_second
+// Usage: ./TreapBenchmark [n] [sortedN]
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+#include "BST.h"
+#include "Treap.h"
+using namespace std;
+
+typedef chrono::steady_clock Clock;
+
+void runOrder(const char* order, const vector<int> &keys, long &checksum);
+void report(const char* structure, const char* operation, const char* order, int n, int ops, double seconds);
+
+int main(int argc, char** argv){
+  int n = (argc > 1) ? atoi(argv[1]) : 1000000;
+  int sortedN = (argc > 2) ? atoi(argv[2]) : 20000;
+
+  mt19937 gen(40);
+  vector<int> randomKeys(n);
+  for (int i = 0; i < n; i++){
+    randomKeys[i] = i;
+  }
+  shuffle(randomKeys.begin(), randomKeys.end(), gen);
+
+  vector<int> sortedKeys(sortedN);
+  for (int i = 0; i < sortedN; i++){
+    sortedKeys[i] = i;
+  }
+
+  long checksum = 0;
+  runOrder("random", randomKeys, checksum);
+  runOrder("sorted", sortedKeys, checksum);
+
+  cerr << "checksum " << checksum << endl;
+  return 0;
+}
+
+/****************************************************************
+ * Time insert, search and removal of the middle half of the    *
+ * keys for BST and Treap, then Treap concatenation             *
+ * order - const char* - name of the insert order               *
+ * keys - const vector<int> & - keys 0..n-1 in insert order     *
+ * checksum - long & - accumulates results so work is not       *
+ *   optimized away                                             *
+ * *************************************************************/
+void runOrder(const char* order, const vector<int> &keys, long &checksum){
+  int n = keys.size();
+  int lo = n / 4;
+  int hi = lo + n / 2 - 1;
+  Clock::time_point start;
+
+  {
+    BST bst;
+    start = Clock::now();
+    for (int i = 0; i < n; i++){ bst.insertValue(keys[i]); }
+    report("BST", "insert", order, n, n, chrono::duration<double>(Clock::now() - start).count());
+
+    start = Clock::now();
+    for (int i = 0; i < n; i++){ checksum += (bst.search(keys[i]) != nullptr); }
+    report("BST", "search", order, n, n, chrono::duration<double>(Clock::now() - start).count());
+
+    start = Clock::now();
+    for (int v = lo; v <= hi; v++){ bst.deleteValue(v); }
+    report("BST", "eraseRange", order, n, hi - lo + 1, chrono::duration<double>(Clock::now() - start).count());
+    checksum += (bst.search(lo) != nullptr);
+  }
+
+  {
+    Treap treap(1);
+    start = Clock::now();
+    for (int i = 0; i < n; i++){ treap.insertValue(keys[i]); }
+    report("Treap", "insert", order, n, n, chrono::duration<double>(Clock::now() - start).count());
+
+    start = Clock::now();
+    for (int i = 0; i < n; i++){ checksum += (treap.search(keys[i]) != nullptr); }
+    report("Treap", "search", order, n, n, chrono::duration<double>(Clock::now() - start).count());
+
+    start = Clock::now();
+    checksum += treap.eraseRange(lo, hi);
+    report("Treap", "eraseRange", order, n, hi - lo + 1, chrono::duration<double>(Clock::now() - start).count());
+  }
+
+  {
+    Treap lower(2), upper(3);
+    for (int i = 0; i < n; i++){
+      if (keys[i] < n / 2) {
+        lower.insertValue(keys[i]);
+      } else {
+        upper.insertValue(keys[i]);
+      }
+    }
+    start = Clock::now();
+    lower.concatenate(upper);
+    report("Treap", "concatenate", order, n, 1, chrono::duration<double>(Clock::now() - start).count());
+    checksum += lower.size;
+  }
+}
+
+/****************************************************************
+ * Print one CSV result line                                    *
+ * structure - const char* - name of the tree measured          *
+ * operation - const char* - name of the operation timed        *
+ * order - const char* - order keys were inserted in            *
+ * n - int - number of keys inserted                            *
+ * ops - int - number of operations timed                       *
+ * seconds - double - time taken by all operations              *
+ * *************************************************************/
+void report(const char* structure, const char* operation, const char* order, int n, int ops, double seconds){
+  cout << structure << "," << operation << "," << order << "," << n << "," << seconds << "," << (ops / seconds) << endl;
+}
@@ -0,0 +1,18 @@
+// File: TreapNode.cpp
+// Description: File contains constructors for TreapNode.
+
+#include "TreapNode.h"
+
+TreapNode::TreapNode(){
+  value = 0;
+  priority = 0;
+  left = nullptr;
+  right = nullptr;
+}
+
+TreapNode::TreapNode(int v, unsigned p){
+  value = v;
+  priority = p;
+  left = nullptr;
+  right = nullptr;
+}
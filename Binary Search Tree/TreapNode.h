@@ -0,0 +1,22 @@
+// File: TreapNode.h
+// Description: Node of a Treap. Values are ordered as in a binary search
+// tree and priorities as in a max-heap, so the shape depends only on the
+// random priorities and not on the order values arrive in.
+
+#ifndef TREAPNODE_H
+#define TREAPNODE_H
+
+#include <memory>
+
+class TreapNode{
+  public:
+    int value;
+    unsigned priority;
+    std::shared_ptr<TreapNode> left;
+    std::shared_ptr<TreapNode> right;
+
+    TreapNode();
+    TreapNode(int, unsigned);
+};
+
+#endif
@@ -0,0 +1,21 @@
+// File: RedBlackNode.cpp
+// Description: File contains constructors for RedBlackNode. New nodes are
+// red, as insertion expects.
+
+#include "RedBlackNode.h"
+
+RedBlackNode::RedBlackNode(){
+  value = 0;
+  red = true;
+  left = nullptr;
+  right = nullptr;
+  parent = nullptr;
+}
+
+RedBlackNode::RedBlackNode(int v){
+  value = v;
+  red = true;
+  left = nullptr;
+  right = nullptr;
+  parent = nullptr;
+}
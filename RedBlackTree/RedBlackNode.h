@@ -0,0 +1,23 @@
+// File: RedBlackNode.h
+// Description: Node of a RedBlackTree. A single color bit replaces the
+// height that AVLNode keeps, so updates only touch a node's color and
+// links, never a per level height.
+
+#ifndef REDBLACKNODE_H
+#define REDBLACKNODE_H
+
+#include <memory>
+
+class RedBlackNode{
+  public:
+    int value;
+    bool red;
+    std::shared_ptr<RedBlackNode> left;
+    std::shared_ptr<RedBlackNode> right;
+    RedBlackNode* parent; // non-owning, children are owned through left and right
+
+    RedBlackNode();
+    RedBlackNode(int);
+};
+
+#endif
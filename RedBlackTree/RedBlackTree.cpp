@@ -0,0 +1,390 @@
+// File: RedBlackTree.cpp
+// Description: File contains constructor for a red-black tree and common
+// functions to interact with the tree. Insert and delete follow the
+// classic bottom up algorithms, walking parent links from the changed
+// node instead of recursing from the root.
+
+#include <climits>
+#include "RedBlackTree.h"
+
+// Constructor for RedBlackTree class
+RedBlackTree::RedBlackTree(){
+  root = nullptr;
+  size = 0;
+}
+
+/*Description: Function returns pointer to RedBlackTree root.
+  Parameters: N/A
+  Returns: std::shared_ptr<RedBlackNode>
+*/
+std::shared_ptr<RedBlackNode> RedBlackTree::getRoot(){
+  return root;
+}
+
+/*Description: Function returns size of RedBlackTree
+  Parameters: N/A
+  Returns: int size
+*/
+int RedBlackTree::getSize(){
+  return size;
+}
+
+/*Description: Function returns pointer to node of RedBlackTree containing
+  val provided. Else returns nullptr
+  Parameters: int val
+  Returns: std::shared_ptr<RedBlackNode>
+*/
+std::shared_ptr<RedBlackNode> RedBlackTree::search(int val){
+  const std::shared_ptr<RedBlackNode>* slot = &root;
+  RedBlackNode* n = root.get();
+  while (n != nullptr && n->value != val) {
+    slot = (n->value < val) ? &n->right : &n->left;
+    n = slot->get();
+  }
+  return (n == nullptr) ? nullptr : *slot;
+}
+
+/*Description: Function returns pointer to node of RedBlackTree containing
+  smallest value.
+  Parameters: N/A
+  Returns: std::shared_ptr<RedBlackNode>
+*/
+std::shared_ptr<RedBlackNode> RedBlackTree::minimum(){
+  if (root == nullptr) {
+    return nullptr;
+  }
+  const std::shared_ptr<RedBlackNode>* slot = &root;
+  while ((*slot)->left != nullptr) {
+    slot = &(*slot)->left;
+  }
+  return *slot;
+}
+
+/*Description: Function returns pointer to node of RedBlackTree containing
+  largest value.
+  Parameters: N/A
+  Returns: std::shared_ptr<RedBlackNode>
+*/
+std::shared_ptr<RedBlackNode> RedBlackTree::maximum(){
+  if (root == nullptr) {
+    return nullptr;
+  }
+  const std::shared_ptr<RedBlackNode>* slot = &root;
+  while ((*slot)->right != nullptr) {
+    slot = &(*slot)->right;
+  }
+  return *slot;
+}
+
+/*Description: Function inserts val as a red leaf, then repairs any red
+  node with a red parent on the way up. Repeat values are not added.
+  Parameters: int val
+  Returns: void
+*/
+void RedBlackTree::insertValue(int val){
+  RedBlackNode* parent = nullptr;
+  std::shared_ptr<RedBlackNode>* slot = &root;
+  while (*slot != nullptr) {
+    parent = slot->get();
+    if (val == parent->value) {
+      return;
+    }
+    slot = (val < parent->value) ? &parent->left : &parent->right;
+  }
+
+  *slot = std::make_shared<RedBlackNode>(val);
+  (*slot)->parent = parent;
+  size = size + 1;
+  insertFixUp(slot->get());
+}
+
+/*Description: Function removes node containing val if present. A node
+  with two children takes its successor's value and the successor is
+  removed instead, so the node unlinked always has at most one child.
+  Parameters: int val
+  Returns: void
+*/
+void RedBlackTree::deleteValue(int val){
+  RedBlackNode* n = root.get();
+  while (n != nullptr && n->value != val) {
+    n = (n->value < val) ? n->right.get() : n->left.get();
+  }
+  if (n == nullptr) {
+    return;
+  }
+
+  if (n->left != nullptr && n->right != nullptr) {
+    RedBlackNode* successor = n->right.get();
+    while (successor->left != nullptr) {
+      successor = successor->left.get();
+    }
+    n->value = successor->value;
+    n = successor;
+  }
+
+  std::shared_ptr<RedBlackNode> child = (n->left != nullptr) ? n->left : n->right;
+  RedBlackNode* parent = n->parent;
+  bool removedRed = n->red;
+  if (child != nullptr) {
+    child->parent = parent;
+  }
+  slotOf(n) = child; // releases n
+  size = size - 1;
+
+  // Removing a black node leaves its side one black short
+  if (!removedRed) {
+    deleteFixUp(child.get(), parent);
+  }
+}
+
+/*Description: Function returns true if the tree is ordered, has no red
+  node with a red child, and every path from the root to an empty subtree
+  crosses the same number of black nodes.
+  Parameters: N/A
+  Returns: bool
+*/
+bool RedBlackTree::isRedBlack(){
+  if (isRed(root.get())) {
+    return false;
+  }
+  return blackHeight(root.get(), (long long)INT_MIN - 1, (long long)INT_MAX + 1) >= 0;
+}
+
+/*Description: Function outputs preorder traversal of given tree to vector.
+  Parameters: std::shared_ptr<RedBlackNode> n,
+  std::vector<std::shared_ptr<RedBlackNode>> &order
+  Returns: void
+*/
+void RedBlackTree::preOrder(std::shared_ptr<RedBlackNode> n, std::vector<std::shared_ptr<RedBlackNode>> &order){
+  if (n != nullptr) {
+    order.push_back(n);
+    preOrder(n->left, order);
+    preOrder(n->right, order);
+  }
+}
+
+/*Description: Function passes nodes of given tree to a vector in
+  ascending order.
+  Parameters: std::shared_ptr<RedBlackNode> n,
+  std::vector<std::shared_ptr<RedBlackNode>> &order
+  Returns: void
+*/
+void RedBlackTree::inOrder(std::shared_ptr<RedBlackNode> n, std::vector<std::shared_ptr<RedBlackNode>> &order){
+  if (n != nullptr) {
+    inOrder(n->left, order);
+    order.push_back(n);
+    inOrder(n->right, order);
+  }
+}
+
+/*Description: Function passes nodes of given tree to a vector in post
+  order.
+  Parameters: std::shared_ptr<RedBlackNode> n,
+  std::vector<std::shared_ptr<RedBlackNode>> &order
+  Returns: void
+*/
+void RedBlackTree::postOrder(std::shared_ptr<RedBlackNode> n, std::vector<std::shared_ptr<RedBlackNode>> &order){
+  if (n != nullptr) {
+    postOrder(n->left, order);
+    postOrder(n->right, order);
+    order.push_back(n);
+  }
+}
+
+/*Description: Function returns the owning pointer that holds n, either
+  root or a child link of n's parent.
+  Parameters: RedBlackNode* n
+  Returns: std::shared_ptr<RedBlackNode>&
+*/
+std::shared_ptr<RedBlackNode>& RedBlackTree::slotOf(RedBlackNode* n){
+  if (n->parent == nullptr) {
+    return root;
+  }
+  return (n->parent->left.get() == n) ? n->parent->left : n->parent->right;
+}
+
+// Empty subtrees count as black.
+bool RedBlackTree::isRed(RedBlackNode* n){
+  return n != nullptr && n->red;
+}
+
+/*Description: Function restores the red-black properties after n was
+  inserted red. While n's parent is red: a red uncle is fixed by
+  recoloring and moving two levels up; a black uncle is fixed by at most
+  two rotations, after which the loop ends.
+  Parameters: RedBlackNode* n
+  Returns: void
+*/
+void RedBlackTree::insertFixUp(RedBlackNode* n){
+  while (isRed(n->parent)) {
+    RedBlackNode* p = n->parent;
+    RedBlackNode* g = p->parent; // exists because the root is black
+    if (p == g->left.get()) {
+      RedBlackNode* uncle = g->right.get();
+      if (isRed(uncle)) {
+        p->red = false;
+        uncle->red = false;
+        g->red = true;
+        n = g;
+      } else {
+        if (n == p->right.get()) {
+          n = p;
+          rotateLeft(n);
+          p = n->parent;
+        }
+        p->red = false;
+        g->red = true;
+        rotateRight(g);
+      }
+    } else {
+      RedBlackNode* uncle = g->left.get();
+      if (isRed(uncle)) {
+        p->red = false;
+        uncle->red = false;
+        g->red = true;
+        n = g;
+      } else {
+        if (n == p->left.get()) {
+          n = p;
+          rotateRight(n);
+          p = n->parent;
+        }
+        p->red = false;
+        g->red = true;
+        rotateLeft(g);
+      }
+    }
+  }
+  root->red = false;
+}
+
+/*Description: Function restores the red-black properties after a black
+  node was removed from below parent, leaving n (possibly empty) one black
+  short. Recoloring the sibling pushes the deficit up; otherwise at most
+  three rotations absorb it and the loop ends.
+  Parameters: RedBlackNode* n, RedBlackNode* parent
+  Returns: void
+*/
+void RedBlackTree::deleteFixUp(RedBlackNode* n, RedBlackNode* parent){
+  while (n != root.get() && !isRed(n)) {
+    if (n == parent->left.get()) {
+      RedBlackNode* sibling = parent->right.get(); // not empty, it holds a black node n lacks
+      if (isRed(sibling)) {
+        sibling->red = false;
+        parent->red = true;
+        rotateLeft(parent);
+        sibling = parent->right.get();
+      }
+      if (!isRed(sibling->left.get()) && !isRed(sibling->right.get())) {
+        sibling->red = true;
+        n = parent;
+        parent = n->parent;
+      } else {
+        if (!isRed(sibling->right.get())) {
+          sibling->left->red = false;
+          sibling->red = true;
+          rotateRight(sibling);
+          sibling = parent->right.get();
+        }
+        sibling->red = parent->red;
+        parent->red = false;
+        sibling->right->red = false;
+        rotateLeft(parent);
+        n = root.get();
+      }
+    } else {
+      RedBlackNode* sibling = parent->left.get();
+      if (isRed(sibling)) {
+        sibling->red = false;
+        parent->red = true;
+        rotateRight(parent);
+        sibling = parent->left.get();
+      }
+      if (!isRed(sibling->left.get()) && !isRed(sibling->right.get())) {
+        sibling->red = true;
+        n = parent;
+        parent = n->parent;
+      } else {
+        if (!isRed(sibling->left.get())) {
+          sibling->right->red = false;
+          sibling->red = true;
+          rotateLeft(sibling);
+          sibling = parent->left.get();
+        }
+        sibling->red = parent->red;
+        parent->red = false;
+        sibling->left->red = false;
+        rotateRight(parent);
+        n = root.get();
+      }
+    }
+  }
+  if (n != nullptr) {
+    n->red = false;
+  }
+}
+
+/*Description: Function rotates n left so its right child takes its place.
+  Parameters: RedBlackNode* n
+  Returns: void
+*/
+void RedBlackTree::rotateLeft(RedBlackNode* n){
+  std::shared_ptr<RedBlackNode>& slot = slotOf(n);
+  std::shared_ptr<RedBlackNode> self = slot;
+  std::shared_ptr<RedBlackNode> temp = n->right;
+
+  n->right = temp->left;
+  if (n->right != nullptr) {
+    n->right->parent = n;
+  }
+  temp->parent = n->parent;
+  slot = temp;
+  temp->left = self;
+  n->parent = temp.get();
+}
+
+/*Description: Function rotates n right so its left child takes its place.
+  Parameters: RedBlackNode* n
+  Returns: void
+*/
+void RedBlackTree::rotateRight(RedBlackNode* n){
+  std::shared_ptr<RedBlackNode>& slot = slotOf(n);
+  std::shared_ptr<RedBlackNode> self = slot;
+  std::shared_ptr<RedBlackNode> temp = n->left;
+
+  n->left = temp->right;
+  if (n->left != nullptr) {
+    n->left->parent = n;
+  }
+  temp->parent = n->parent;
+  slot = temp;
+  temp->right = self;
+  n->parent = temp.get();
+}
+
+/*Description: Function returns the number of black nodes on every path
+  from n to an empty subtree, or -1 if paths differ, values fall outside
+  (lo, hi), a red node has a red child, or a parent link is wrong.
+  Parameters: RedBlackNode* n, long long lo, long long hi
+  Returns: int
+*/
+int RedBlackTree::blackHeight(RedBlackNode* n, long long lo, long long hi){
+  if (n == nullptr) {
+    return 0;
+  }
+  if (n->value <= lo || n->value >= hi) {
+    return -1;
+  }
+  if (n->red && (isRed(n->left.get()) || isRed(n->right.get()))) {
+    return -1;
+  }
+  if ((n->left != nullptr && n->left->parent != n) || (n->right != nullptr && n->right->parent != n)) {
+    return -1;
+  }
+  int leftHeight = blackHeight(n->left.get(), lo, n->value);
+  int rightHeight = blackHeight(n->right.get(), n->value, hi);
+  if (leftHeight < 0 || leftHeight != rightHeight) {
+    return -1;
+  }
+  return leftHeight + (n->red ? 0 : 1);
+}
@@ -0,0 +1,50 @@
+// File: RedBlackTree.h
+// Description: Red-black tree of ints with the same public interface as
+// AVLTree. An insert performs at most two rotations and a delete at most
+// three; the remaining repair work is recoloring, which is amortized O(1)
+// per update. Lookups may walk up to twice as deep as in an AVL tree.
+
+#ifndef REDBLACKTREE_H
+#define REDBLACKTREE_H
+
+#include <memory>
+#include <vector>
+#include "RedBlackNode.h"
+
+class RedBlackTree{
+  public:
+    RedBlackTree();
+
+    std::shared_ptr<RedBlackNode> getRoot();
+    int getSize();
+
+    std::shared_ptr<RedBlackNode> search(int);
+
+    std::shared_ptr<RedBlackNode> minimum();
+    std::shared_ptr<RedBlackNode> maximum();
+
+    void insertValue(int);
+    void deleteValue(int);
+
+    bool isRedBlack();
+
+    void preOrder(std::shared_ptr<RedBlackNode>, std::vector<std::shared_ptr<RedBlackNode>>&);
+    void inOrder(std::shared_ptr<RedBlackNode>, std::vector<std::shared_ptr<RedBlackNode>>&);
+    void postOrder(std::shared_ptr<RedBlackNode>, std::vector<std::shared_ptr<RedBlackNode>>&);
+
+  private:
+    std::shared_ptr<RedBlackNode> root;
+    int size;
+
+    std::shared_ptr<RedBlackNode>& slotOf(RedBlackNode*);
+    static bool isRed(RedBlackNode*);
+
+    void insertFixUp(RedBlackNode*);
+    void deleteFixUp(RedBlackNode*, RedBlackNode*);
+    void rotateLeft(RedBlackNode*);
+    void rotateRight(RedBlackNode*);
+
+    int blackHeight(RedBlackNode*, long long, long long);
+};
+
+#endif
@@ -0,0 +1,115 @@
+// File: RedBlackTreeBenchmark.cpp
+// Description: Runs the same operation traces against RedBlackTree and
+// AVLTree. Each trace is generated once and replayed on both trees:
+//   insert - starts empty, 70% insert, 20% search, 10% delete
+//   delete - starts with n keys, 70% delete, 20% search, 10% insert
+//   read   - starts with n keys, 90% search, 5% insert, 5% delete
+// Prints one CSV line per structure and trace:
+//   structure,trace,n,seconds,ops_per_second
+// Usage: ./RedBlackTreeBenchmark [n] [ops]
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+#include "RedBlackTree.h"
+#include "AVLTree.h"
+using namespace std;
+
+typedef chrono::steady_clock Clock;
+
+struct Operation{
+  int kind; // 0 search, 1 insert, 2 delete
+  int key;
+};
+
+vector<Operation> makeTrace(int ops, int keyRange, int searchPercent, int insertPercent, mt19937 &gen);
+template <typename Tree>
+void runTrace(const char* structure, const char* trace, const vector<int> &prefill,
+              const vector<Operation> &operations, long &checksum);
+
+int main(int argc, char** argv){
+  int n = (argc > 1) ? atoi(argv[1]) : 1000000;
+  int ops = (argc > 2) ? atoi(argv[2]) : 2000000;
+  int keyRange = 2 * n;
+
+  mt19937 gen(38);
+  vector<int> prefill(n);
+  for (int i = 0; i < n; i++){
+    prefill[i] = 2 * i;
+  }
+  shuffle(prefill.begin(), prefill.end(), gen);
+  vector<int> empty;
+
+  vector<Operation> insertTrace = makeTrace(ops, keyRange, 20, 70, gen);
+  vector<Operation> deleteTrace = makeTrace(ops, keyRange, 20, 10, gen);
+  vector<Operation> readTrace = makeTrace(ops, keyRange, 90, 5, gen);
+
+  long checksum = 0;
+  runTrace<RedBlackTree>("RedBlackTree", "insert", empty, insertTrace, checksum);
+  runTrace<AVLTree>("AVLTree", "insert", empty, insertTrace, checksum);
+  runTrace<RedBlackTree>("RedBlackTree", "delete", prefill, deleteTrace, checksum);
+  runTrace<AVLTree>("AVLTree", "delete", prefill, deleteTrace, checksum);
+  runTrace<RedBlackTree>("RedBlackTree", "read", prefill, readTrace, checksum);
+  runTrace<AVLTree>("AVLTree", "read", prefill, readTrace, checksum);
+
+  cerr << "checksum " << checksum << endl;
+  return 0;
+}
+
+/*****************************************************************************
+ * Generate a trace of random operations on keys in [0, keyRange). Whatever *
+ * is not search or insert is delete                                         *
+ * ops - int - number of operations                                          *
+ * keyRange - int - keys are drawn uniformly below this bound                *
+ * searchPercent - int - share of searches                                   *
+ * insertPercent - int - share of inserts                                    *
+ * gen - mt19937 & - random source                                           *
+ * **************************************************************************/
+vector<Operation> makeTrace(int ops, int keyRange, int searchPercent, int insertPercent, mt19937 &gen){
+  uniform_int_distribution<int> pickKey(0, keyRange - 1);
+  uniform_int_distribution<int> pickOp(0, 99);
+  vector<Operation> operations(ops);
+  for (int i = 0; i < ops; i++){
+    int op = pickOp(gen);
+    operations[i].kind = (op < searchPercent) ? 0 : ((op < searchPercent + insertPercent) ? 1 : 2);
+    operations[i].key = pickKey(gen);
+  }
+  return operations;
+}
+
+/**************************************************************************
+ * Fill a new tree with prefill, then time replaying operations on it and *
+ * print one CSV line                                                     *
+ * structure - const char* - name of the tree measured                    *
+ * trace - const char* - name of the trace                                *
+ * prefill - const vector<int> & - keys inserted before timing starts     *
+ * operations - const vector<Operation> & - the trace to replay           *
+ * checksum - long & - running count of successful searches               *
+ * ***********************************************************************/
+template <typename Tree>
+void runTrace(const char* structure, const char* trace, const vector<int> &prefill,
+              const vector<Operation> &operations, long &checksum){
+  Tree tree;
+  for (size_t i = 0; i < prefill.size(); i++){
+    tree.insertValue(prefill[i]);
+  }
+
+  Clock::time_point start = Clock::now();
+  for (size_t i = 0; i < operations.size(); i++){
+    const Operation &op = operations[i];
+    if (op.kind == 0){
+      checksum += (tree.search(op.key) != nullptr);
+    } else if (op.kind == 1){
+      tree.insertValue(op.key);
+    } else {
+      tree.deleteValue(op.key);
+    }
+  }
+  double seconds = chrono::duration<double>(Clock::now() - start).count();
+
+  cout << structure << "," << trace << "," << prefill.size() << "," << seconds << ","
+       << (operations.size() / seconds) << endl;
+}
@@ -0,0 +1,128 @@
+// File: RedBlackTreeDriver.cpp
+// Description: Simple main to test red-black tree methods. Uses the same
+// opcodes as the AVL tree driver, plus 10 to check the red-black rules.
+
+#include <iostream>
+#include <vector>
+#include "RedBlackTree.h"
+using namespace std;
+
+void printVector(const vector<std::shared_ptr<RedBlackNode>> &v);
+void runSearch(std::shared_ptr<RedBlackTree> T);
+void runInsert(std::shared_ptr<RedBlackTree> T);
+void runDelete(std::shared_ptr<RedBlackTree> T);
+
+/**********************************************
+ * Simple main to test Red-Black Tree methods *
+ * *******************************************/
+int main(){
+  std::shared_ptr<RedBlackTree> T(new RedBlackTree());
+  std::shared_ptr<RedBlackNode> n;
+
+  int operation;
+  cin >> operation;
+
+  while (operation > 0){
+    vector<std::shared_ptr<RedBlackNode>> order;
+    switch(operation){
+      case 1: // search
+        cout << "SEARCH FOR ";
+        runSearch(T);
+        break;
+      case 2: // insert
+        cout << "INSERT ";
+        runInsert(T);
+        break;
+      case 3: // delete
+        cout << "DELETE ";
+        runDelete(T);
+        break;
+      case 4: // preorder
+        cout << "PREORDER" << endl;
+        T->preOrder(T->getRoot(), order);
+        printVector(order);
+        break;
+      case 5: // inorder
+        cout << "INORDER" << endl;
+        T->inOrder(T->getRoot(), order);
+        printVector(order);
+        break;
+      case 6: // postorder
+        cout << "POSTORDER" << endl;
+        T->postOrder(T->getRoot(), order);
+        printVector(order);
+        break;
+      case 7: // minimum
+        cout << "MINIMUM" << endl;
+        n = T->minimum();
+        if (n != nullptr){ cout << n->value << endl; }
+        else{ cout << "null" << endl; }
+        break;
+      case 8: // maximum
+        cout << "MAXIMUM" << endl;
+        n = T->maximum();
+        if (n != nullptr){ cout << n->value << endl; }
+        else{ cout << "null" << endl; }
+        break;
+      case 9: // size
+        cout << "SIZE" << endl;
+        cout << T->getSize() << endl;
+        break;
+      case 10: // is red-black
+        cout << "IS RED BLACK" << endl;
+        cout << T->isRedBlack() << endl;
+        break;
+      default:
+        break;
+    }
+    cin >> operation;
+  }
+
+  return 0;
+}
+
+/*********************************************************************************
+ * Print the values of nodes in a vector, marking red nodes with a trailing r    *
+ * v - const vector<std::shared_ptr<RedBlackNode>> & - a vector of RedBlackNodes *
+ * ******************************************************************************/
+void printVector(const vector<std::shared_ptr<RedBlackNode>> &v){
+  for (int i = 0; i < v.size(); i++){
+    cout << v[i]->value << (v[i]->red ? "r " : " ");
+  }
+  cout << endl;
+}
+
+/*******************************************************************************************************
+ * Given a Red-Black Tree, get a value to search for from the console and apply the tree search method *
+ * T - std::shared_ptr<RedBlackTree> - a Red-Black Tree                                                *
+ * ****************************************************************************************************/
+void runSearch(std::shared_ptr<RedBlackTree> T){
+  int target;
+  cin >> target;
+  cout << target << endl;
+  std::shared_ptr<RedBlackNode> n = T->search(target);
+  if (n){ cout << n->value << endl; }
+  else{ cout << "Not found" << endl; }
+}
+
+/*******************************************************************************
+ * Given a Red-Black Tree, get a value from the console and add it to the tree *
+ * T - std::shared_ptr<RedBlackTree> - a Red-Black Tree                        *
+ * ****************************************************************************/
+void runInsert(std::shared_ptr<RedBlackTree> T){
+  int newVal;
+  cin >> newVal;
+  cout << newVal << endl;
+  T->insertValue(newVal);
+}
+
+/*************************************************************************************************
+ * Given a Red-Black Tree, get a value from the console and remove it from the tree if it exists *
+ * T - std::shared_ptr<RedBlackTree> - a Red-Black Tree                                          *
+ * **********************************************************************************************/
+void runDelete(std::shared_ptr<RedBlackTree> T){
+  int remove;
+  cin >> remove;
+  cout << remove << endl;
+  T->deleteValue(remove);
+}